@@ -0,0 +1,427 @@
+/*!
+ *  \file main.cpp
+ *  \brief Micro-benchmarks comparing sc::list against std::list, std::deque and std::vector.
+ *
+ *  Usage: `benchmarks [--type=int|pod64|string] [size ...]`
+ *
+ *  Sizes may be written in scientific notation (e.g. `1e6`) and default to
+ *  10, 1000 and 100000. Every cell reports the average time per element touched
+ *  by the operation (ns/op) and the matching throughput in millions of
+ *  elements per second. Operations a container does not support are shown as
+ *  `-`.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "list.h"
+
+namespace {
+
+//=== Element types
+
+//! A 64-byte trivially copyable record, ordered by `key`.
+struct pod64 {
+  std::uint64_t key;
+  std::uint64_t payload[7];
+};
+
+bool operator<(const pod64 &a, const pod64 &b) { return a.key < b.key; }
+bool operator==(const pod64 &a, const pod64 &b) { return a.key == b.key; }
+
+static_assert(sizeof(pod64) == 64, "pod64 must be 64 bytes");
+
+//! Builds the element with key `k`; equal keys give equal elements and the order follows the keys.
+template <typename T> T make_value(std::uint64_t k);
+
+template <> int make_value<int>(std::uint64_t k) { return static_cast<int>(k); }
+
+template <> pod64 make_value<pod64>(std::uint64_t k) {
+  pod64 v{};
+  v.key = k;
+  return v;
+}
+
+// Zero padded to 20 digits, so the strings do not fit in the small string buffer.
+template <> std::string make_value<std::string>(std::uint64_t k) {
+  char buf[24];
+  std::snprintf(buf, sizeof buf, "%020llu", static_cast<unsigned long long>(k));
+  return buf;
+}
+
+//! Folds an element into the checksum, so traversals cannot be optimized away.
+std::uint64_t digest(int v) { return static_cast<std::uint64_t>(v); }
+std::uint64_t digest(const pod64 &v) { return v.key; }
+std::uint64_t digest(const std::string &v) { return v.size() + static_cast<unsigned char>(v.back()); }
+
+volatile std::uint64_t g_sink = 0;
+
+//! Pseudo-random but reproducible keys, for the sort benchmark.
+std::uint64_t scramble(std::uint64_t i) {
+  i ^= i >> 33;
+  i *= 0xff51afd7ed558ccdULL;
+  i ^= i >> 33;
+  return i % 1000000007ULL;
+}
+
+//=== Container traits
+
+template <typename C> struct is_sc_list : std::false_type {};
+template <typename T, typename A> struct is_sc_list<sc::list<T, A>> : std::true_type {};
+
+template <typename C> struct is_std_list : std::false_type {};
+template <typename T, typename A> struct is_std_list<std::list<T, A>> : std::true_type {};
+
+template <typename C>
+constexpr bool is_linked = is_sc_list<C>::value || is_std_list<C>::value;
+
+template <typename C>
+constexpr bool has_front_ops = !std::is_same<C, std::vector<typename C::value_type>>::value;
+
+//=== Timing
+
+using bench_clock = std::chrono::steady_clock;
+
+//! Outcome of one benchmark cell; `ops == 0` means the container does not support the operation.
+struct result {
+  double ns = 0;
+  double ops = 0;
+};
+
+//! Accumulates the time spent between `start()` and `stop()` calls.
+struct round_timer {
+  bench_clock::time_point begin;
+  double ns = 0;
+  void start() { begin = bench_clock::now(); }
+  void stop() {
+    ns += std::chrono::duration<double, std::nano>(bench_clock::now() - begin).count();
+  }
+};
+
+//! Roughly how many elements each benchmark cell processes, to smooth out small sizes.
+constexpr double budget = 1 << 18;
+
+/*!
+ *  Runs `round(timer)` until about `budget` elements have been processed.
+ *  Each round builds its own input and calls `timer.start()`/`timer.stop()`
+ *  around the part that is measured.
+ *  \param ops_per_round Elements touched by the measured part of one round.
+ *  \param n Size of the input, which bounds the number of rounds since building it is not free.
+ *  \return The accumulated time and element count.
+ */
+template <typename Round>
+result measure(std::size_t ops_per_round, std::size_t n, Round round) {
+  std::size_t work = std::max(ops_per_round, n);
+  std::size_t rounds = std::max<std::size_t>(1, static_cast<std::size_t>(budget / work));
+  rounds = std::min<std::size_t>(rounds, 10000);
+  round_timer timer;
+  for (std::size_t r{0}; r < rounds; ++r) {
+    round(timer);
+  }
+  return {timer.ns, static_cast<double>(rounds * ops_per_round)};
+}
+
+template <typename C>
+C make_sequence(std::size_t n, std::uint64_t step = 1, std::uint64_t offset = 0) {
+  C c;
+  for (std::size_t i{0}; i < n; ++i) {
+    c.push_back(make_value<typename C::value_type>(i * step + offset));
+  }
+  return c;
+}
+
+//! Number of elements inserted or erased in the middle; kept small since each one costs O(n) in the arrays.
+std::size_t middle_ops(std::size_t n) {
+  return std::min<std::size_t>(n, 100);
+}
+
+//=== Operations
+
+template <typename C> result bench_push_back(std::size_t n) {
+  using T = typename C::value_type;
+  return measure(n, n, [n](round_timer &t) {
+    C c;
+    t.start();
+    for (std::size_t i{0}; i < n; ++i) { c.push_back(make_value<T>(i)); }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_push_front(std::size_t n) {
+  using T = typename C::value_type;
+  if constexpr (has_front_ops<C>) {
+    return measure(n, n, [n](round_timer &t) {
+      C c;
+      t.start();
+      for (std::size_t i{0}; i < n; ++i) { c.push_front(make_value<T>(i)); }
+      t.stop();
+    });
+  } else {
+    return {};
+  }
+}
+
+template <typename C> result bench_pop_back(std::size_t n) {
+  return measure(n, n, [n](round_timer &t) {
+    C c = make_sequence<C>(n);
+    t.start();
+    for (std::size_t i{0}; i < n; ++i) { c.pop_back(); }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_pop_front(std::size_t n) {
+  if constexpr (has_front_ops<C>) {
+    return measure(n, n, [n](round_timer &t) {
+      C c = make_sequence<C>(n);
+      t.start();
+      for (std::size_t i{0}; i < n; ++i) { c.pop_front(); }
+      t.stop();
+    });
+  } else {
+    return {};
+  }
+}
+
+template <typename C> result bench_insert_middle(std::size_t n) {
+  using T = typename C::value_type;
+  std::size_t k = middle_ops(n);
+  return measure(k, n, [n, k](round_timer &t) {
+    C c = make_sequence<C>(n);
+    auto it = std::next(c.begin(), static_cast<std::ptrdiff_t>(n / 2));
+    t.start();
+    for (std::size_t i{0}; i < k; ++i) { it = c.insert(it, make_value<T>(i)); }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_erase_middle(std::size_t n) {
+  std::size_t k = middle_ops(n);
+  return measure(k, n, [n, k](round_timer &t) {
+    C c = make_sequence<C>(n);
+    auto it = std::next(c.begin(), static_cast<std::ptrdiff_t>((n - k) / 2));
+    t.start();
+    for (std::size_t i{0}; i < k; ++i) { it = c.erase(it); }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_traverse(std::size_t n) {
+  C c = make_sequence<C>(n);
+  return measure(n, n, [&c](round_timer &t) {
+    std::uint64_t sum = 0;
+    t.start();
+    for (auto it = c.begin(); it != c.end(); ++it) { sum += digest(*it); }
+    t.stop();
+    g_sink = g_sink + sum;
+  });
+}
+
+template <typename C> result bench_find(std::size_t n) {
+  using T = typename C::value_type;
+  C c = make_sequence<C>(n);
+  const T missing = make_value<T>(n);
+  return measure(n, n, [&c, &missing](round_timer &t) {
+    t.start();
+    auto it = std::find(c.begin(), c.end(), missing);
+    t.stop();
+    g_sink = g_sink + (it == c.end());
+  });
+}
+
+template <typename C> result bench_sort(std::size_t n) {
+  using T = typename C::value_type;
+  return measure(n, n, [n](round_timer &t) {
+    C c;
+    for (std::size_t i{0}; i < n; ++i) { c.push_back(make_value<T>(scramble(i))); }
+    t.start();
+    if constexpr (is_linked<C>) {
+      c.sort();
+    } else {
+      std::sort(c.begin(), c.end());
+    }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_merge(std::size_t n) {
+  return measure(n, n, [n](round_timer &t) {
+    C a = make_sequence<C>(n / 2, 2, 0);
+    C b = make_sequence<C>(n - n / 2, 2, 1);
+    t.start();
+    if constexpr (is_linked<C>) {
+      a.merge(b);
+    } else {
+      auto middle = a.size();
+      a.insert(a.end(), std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
+      std::inplace_merge(a.begin(), std::next(a.begin(), static_cast<std::ptrdiff_t>(middle)), a.end());
+    }
+    t.stop();
+  });
+}
+
+//! Moves a whole container into the middle of another one; lists relink, arrays move elements.
+template <typename C> result bench_splice(std::size_t n) {
+  return measure(n, n, [n](round_timer &t) {
+    C a = make_sequence<C>(n / 2);
+    C b = make_sequence<C>(n - n / 2);
+    auto pos = std::next(a.begin(), static_cast<std::ptrdiff_t>(a.size() / 2));
+    t.start();
+    if constexpr (is_linked<C>) {
+      a.splice(pos, b);
+    } else {
+      a.insert(pos, std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
+    }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_reverse(std::size_t n) {
+  return measure(n, n, [n](round_timer &t) {
+    C c = make_sequence<C>(n);
+    t.start();
+    if constexpr (is_linked<C>) {
+      c.reverse();
+    } else {
+      std::reverse(c.begin(), c.end());
+    }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_unique(std::size_t n) {
+  using T = typename C::value_type;
+  return measure(n, n, [n](round_timer &t) {
+    C c;
+    for (std::size_t i{0}; i < n; ++i) { c.push_back(make_value<T>(i / 2)); }
+    t.start();
+    if constexpr (is_linked<C>) {
+      c.unique();
+    } else {
+      c.erase(std::unique(c.begin(), c.end()), c.end());
+    }
+    t.stop();
+  });
+}
+
+template <typename C> result bench_copy(std::size_t n) {
+  C c = make_sequence<C>(n);
+  return measure(n, n, [&c](round_timer &t) {
+    t.start();
+    C copy(c);
+    t.stop();
+    g_sink = g_sink + copy.size();
+  });
+}
+
+//=== Report
+
+constexpr std::size_t container_count = 4;
+const char *const container_names[container_count] = {"sc::list", "std::list", "std::deque", "std::vector"};
+
+template <template <typename> class Op, typename T>
+void run_row(const char *name, std::size_t n) {
+  result cells[container_count] = {
+      Op<sc::list<T>>{}(n),
+      Op<std::list<T>>{}(n),
+      Op<std::deque<T>>{}(n),
+      Op<std::vector<T>>{}(n),
+  };
+  std::printf("  %-14s", name);
+  for (const result &cell : cells) {
+    if (cell.ops == 0) {
+      std::printf(" | %24s", "-");
+    } else {
+      double ns = cell.ns / cell.ops;
+      std::printf(" | %9.2f ns %9.1f M/s", ns, ns > 0 ? 1e3 / ns : 0.0);
+    }
+  }
+  std::printf("\n");
+  std::fflush(stdout);
+}
+
+// Class templates wrapping each benchmark, so a row can instantiate it for every container.
+#define SC_BENCH_OP(op)                                              \
+  template <typename C> struct op##_op {                             \
+    result operator()(std::size_t n) const { return bench_##op<C>(n); } \
+  };
+SC_BENCH_OP(push_back)
+SC_BENCH_OP(push_front)
+SC_BENCH_OP(pop_back)
+SC_BENCH_OP(pop_front)
+SC_BENCH_OP(insert_middle)
+SC_BENCH_OP(erase_middle)
+SC_BENCH_OP(traverse)
+SC_BENCH_OP(find)
+SC_BENCH_OP(sort)
+SC_BENCH_OP(merge)
+SC_BENCH_OP(splice)
+SC_BENCH_OP(reverse)
+SC_BENCH_OP(unique)
+SC_BENCH_OP(copy)
+#undef SC_BENCH_OP
+
+template <typename T>
+void run_suite(const char *type_name, std::size_t n) {
+  std::printf("\n== %s, n = %zu\n  %-14s", type_name, n, "operation");
+  for (const char *name : container_names) {
+    std::printf(" | %24s", name);
+  }
+  std::printf("\n");
+  run_row<push_back_op, T>("push_back", n);
+  run_row<push_front_op, T>("push_front", n);
+  run_row<pop_back_op, T>("pop_back", n);
+  run_row<pop_front_op, T>("pop_front", n);
+  run_row<insert_middle_op, T>("insert middle", n);
+  run_row<erase_middle_op, T>("erase middle", n);
+  run_row<traverse_op, T>("traverse", n);
+  run_row<find_op, T>("find", n);
+  run_row<sort_op, T>("sort", n);
+  run_row<merge_op, T>("merge", n);
+  run_row<splice_op, T>("splice", n);
+  run_row<reverse_op, T>("reverse", n);
+  run_row<unique_op, T>("unique", n);
+  run_row<copy_op, T>("copy", n);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<std::size_t> sizes;
+  std::string type = "all";
+
+  for (int i{1}; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg.rfind("--type=", 0) == 0) {
+      type = arg.substr(7);
+      continue;
+    }
+    char *end = nullptr;
+    double value = std::strtod(arg.c_str(), &end);
+    if (end == arg.c_str() || *end != '\0' || value < 2 || value > 1e9) {
+      std::fprintf(stderr, "usage: %s [--type=int|pod64|string] [size ...]  (2 <= size <= 1e9)\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+    sizes.push_back(static_cast<std::size_t>(value));
+  }
+  if (sizes.empty()) {
+    sizes = {10, 1000, 100000};
+  }
+
+  std::printf("ns/op is the time per element touched by the operation; M/s is millions of elements per second.\n");
+  for (std::size_t n : sizes) {
+    if (type == "all" || type == "int") { run_suite<int>("int", n); }
+    if (type == "all" || type == "pod64") { run_suite<pod64>("pod64", n); }
+    if (type == "all" || type == "string") { run_suite<std::string>("std::string", n); }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,485 @@
+#ifndef _COMPACT_LIST_H_
+#define _COMPACT_LIST_H_
+
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <cstdint>          // std::uint32_t
+#include <initializer_list>
+#include <iterator>         // bidirectional_iterator_tag
+#include <new>              // operator new, std::launder
+#include <stdexcept>        // std::out_of_range, std::length_error
+#include <type_traits>
+#include <utility>          // std::move, std::forward, std::swap
+
+namespace sc {
+
+/*!
+ *  \class compact_list
+ *  \brief Doubly-linked list whose nodes sit in one slab and link through 32-bit indices.
+ *
+ *  A node is two `uint32_t` links plus the element, with no allocator
+ *  overhead: 12 bytes for an `int`, against 24 for an `sc::list<int>` node.
+ *  More of a large list fits in cache, and traversals touch one array.
+ *  Slot 0 of the slab is the sentinel; erased slots go on a free list and are
+ *  reused before the slab grows. Growing doubles the slab and moves the live
+ *  elements over, like a vector.
+ *
+ *  Iterators hold slab indices, so they stay valid when the slab grows;
+ *  pointers and references to elements do not.
+ *
+ *  \tparam T The type of the elements.
+ */
+template <typename T>
+class compact_list {
+  using index = std::uint32_t;
+
+  //! A slab entry: the links, then room for one element (empty in the sentinel and in free slots).
+  struct slot {
+    index next;
+    index prev;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *value() { return std::launder(reinterpret_cast<T *>(storage)); }
+  };
+
+  static constexpr index sentinel = 0;
+  //! Largest number of slots, sentinel included, that the links can address.
+  static constexpr std::size_t slot_limit = static_cast<std::size_t>(static_cast<index>(-1)) + 1;
+
+  /*!
+   *  \class iterator_impl
+   *  \brief Bidirectional iterator over a compact list.
+   *  \tparam Const Whether this iterator gives read-only access.
+   */
+  template <bool Const>
+  class iterator_impl {
+  public:
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+  private:
+    using owner = std::conditional_t<Const, const compact_list, compact_list>;
+    owner *m_list; //!< The list, whose slab may move.
+    index m_idx;   //!< Slab index of the current node.
+
+  public:
+    iterator_impl(owner *list = nullptr, index idx = sentinel) : m_list{list}, m_idx{idx} { }
+
+    //! A mutable iterator converts to a const one.
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    iterator_impl(const iterator_impl<false> &other) : m_list{other.m_list}, m_idx{other.m_idx} { }
+
+    reference operator*() const { return *m_list->m_slots[m_idx].value(); }
+    pointer operator->() const { return m_list->m_slots[m_idx].value(); }
+
+    iterator_impl &operator++() {
+      m_idx = m_list->m_slots[m_idx].next;
+      return *this;
+    }
+
+    iterator_impl operator++(int) {
+      iterator_impl temp{*this};
+      ++*this;
+      return temp;
+    }
+
+    iterator_impl &operator--() {
+      m_idx = m_list->m_slots[m_idx].prev;
+      return *this;
+    }
+
+    iterator_impl operator--(int) {
+      iterator_impl temp{*this};
+      --*this;
+      return temp;
+    }
+
+    bool operator==(const iterator_impl &rhs) const { return m_idx == rhs.m_idx; }
+    bool operator!=(const iterator_impl &rhs) const { return m_idx != rhs.m_idx; }
+
+    friend class compact_list;
+    friend class iterator_impl<!Const>;
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = iterator_impl<false>;      //!< Mutable iterator.
+  using const_iterator = iterator_impl<true>; //!< Read-only iterator.
+
+  //=== [I] Special members
+  //! \brief Constructs an empty list; the slab is allocated on the first insertion.
+  compact_list() = default;
+
+  //! \brief Constructs a list with the elements of [first, last).
+  template <typename InputIt>
+  compact_list(InputIt first, InputIt last) {
+    try {
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  //! \brief Constructs a list with the elements of an initializer list.
+  compact_list(std::initializer_list<T> ilist_) : compact_list(ilist_.begin(), ilist_.end()) { }
+
+  //! \brief Copies the elements of `other`, which end up in consecutive slots.
+  compact_list(const compact_list &other) : compact_list() {
+    try {
+      reserve(other.size());
+      for (const T &value : other) {
+        emplace_back(value);
+      }
+    } catch (...) {
+      release();
+      throw;
+    }
+  }
+
+  //! \brief Takes over the slab of `other`, which is left empty.
+  compact_list(compact_list &&other) noexcept { swap(other); }
+
+  compact_list &operator=(const compact_list &rhs) {
+    if (this != &rhs) {
+      compact_list temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  compact_list &operator=(compact_list &&rhs) noexcept {
+    if (this != &rhs) {
+      compact_list temp(std::move(rhs));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  ~compact_list() { release(); }
+
+  void swap(compact_list &other) noexcept {
+    std::swap(m_slots, other.m_slots);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_used, other.m_used);
+    std::swap(m_free, other.m_free);
+    std::swap(m_len, other.m_len);
+  }
+
+  //=== [II] Iterators
+  iterator begin() { return iterator{this, first_index()}; }
+  iterator end() { return iterator{this, sentinel}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_iterator cbegin() const { return const_iterator{this, first_index()}; }
+  const_iterator cend() const { return const_iterator{this, sentinel}; }
+
+  //=== [III] Capacity/Status
+  [[nodiscard]] bool empty() const { return m_len == 0; }
+  [[nodiscard]] size_type size() const { return m_len; }
+
+  //! Largest number of elements the 32-bit links can address.
+  static constexpr size_type max_size() { return slot_limit - 1; }
+
+  //! Number of elements the slab holds without growing.
+  size_type capacity() const { return m_capacity == 0 ? 0 : m_capacity - 1; }
+
+  /*!
+   *  Grows the slab to hold at least `count` elements.
+   *  \throw std::length_error if `count` exceeds max_size().
+   */
+  void reserve(size_type count) {
+    if (count > max_size()) {
+      throw std::length_error("A lista compacta está limitada a 2^32 - 1 elementos");
+    }
+    if (count + 1 > m_capacity) {
+      reallocate(count + 1);
+    }
+  }
+
+  //=== [IV] Access
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &front() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *begin();
+  }
+
+  const T &front() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *cbegin();
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &back() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *--end();
+  }
+
+  const T &back() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *--cend();
+  }
+
+  //=== [V] Modifiers
+  //! Destroys every element; the slab is kept for reuse.
+  void clear() {
+    for (index i = first_index(); i != sentinel;) {
+      index next = m_slots[i].next;
+      m_slots[i].value()->~T();
+      i = next;
+    }
+    if (m_slots != nullptr) {
+      m_slots[sentinel].next = m_slots[sentinel].prev = sentinel;
+    }
+    m_used = m_capacity == 0 ? 0 : 1;
+    m_free = sentinel;
+    m_len = 0;
+  }
+
+  void push_front(const T &value_) { emplace(cbegin(), value_); }
+  void push_front(T &&value_) { emplace(cbegin(), std::move(value_)); }
+  void push_back(const T &value_) { emplace(cend(), value_); }
+  void push_back(T &&value_) { emplace(cend(), std::move(value_)); }
+
+  template <typename... Args>
+  T &emplace_front(Args &&...args) { return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args) { return *emplace(cend(), std::forward<Args>(args)...); }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_front() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(cbegin());
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_back() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(--cend());
+  }
+
+  /*!
+   *  Constructs a new element right before `pos`.
+   *  \return An iterator to the new element.
+   *  \throw std::length_error if the list already holds max_size() elements.
+   */
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    if (m_free == sentinel && m_used == m_capacity) {
+      // The arguments may refer to an element of the slab, which is about to move.
+      T value(std::forward<Args>(args)...);
+      grow();
+      return link_new(pos, std::move(value));
+    }
+    return link_new(pos, std::forward<Args>(args)...);
+  }
+
+  iterator insert(const_iterator pos, const T &value_) { return emplace(pos, value_); }
+  iterator insert(const_iterator pos, T &&value_) { return emplace(pos, std::move(value_)); }
+
+  /*!
+   *  Inserts the elements of [first, last) right before `pos`.
+   *  \return An iterator to the first inserted element, or `pos` if the range is empty.
+   */
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    iterator result{this, pos.m_idx};
+    bool first_one = true;
+    for (; first != last; ++first) {
+      iterator it = emplace(pos, *first);
+      if (first_one) {
+        result = it;
+        first_one = false;
+      }
+    }
+    return result;
+  }
+
+  /*!
+   *  Removes the element at `pos`; its slot goes on the free list.
+   *  \return An iterator to the element that followed it.
+   */
+  iterator erase(const_iterator pos) {
+    index idx = pos.m_idx;
+    slot &s = m_slots[idx];
+    index next = s.next;
+    m_slots[s.prev].next = next;
+    m_slots[next].prev = s.prev;
+    s.value()->~T();
+    give_back(idx);
+    --m_len;
+    return iterator{this, next};
+  }
+
+  //! Removes the elements of [first, last).
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator{this, last.m_idx};
+  }
+
+  //=== [VI] Operations
+  //! Finds the first element equal to `value_`, or returns end().
+  iterator find(const T &value_) {
+    iterator it = begin();
+    while (it != end() && !(*it == value_)) {
+      ++it;
+    }
+    return it;
+  }
+
+  const_iterator find(const T &value_) const {
+    const_iterator it = cbegin();
+    while (it != cend() && !(*it == value_)) {
+      ++it;
+    }
+    return it;
+  }
+
+  //! Reverses the order of the elements by swapping the links of every slot.
+  void reverse() {
+    if (m_slots == nullptr) {
+      return;
+    }
+    index i = sentinel;
+    do {
+      std::swap(m_slots[i].next, m_slots[i].prev);
+      i = m_slots[i].prev; // The old `next`.
+    } while (i != sentinel);
+  }
+
+private:
+  slot *m_slots{nullptr};   //!< The slab; slot 0 is the sentinel.
+  std::size_t m_capacity{0}; //!< Slots in the slab, sentinel included.
+  std::size_t m_used{0};     //!< Slots ever handed out, sentinel included.
+  index m_free{sentinel};    //!< First free slot (linked by `next`), or the sentinel if none.
+  size_type m_len{0};
+
+  index first_index() const { return m_slots == nullptr ? sentinel : m_slots[sentinel].next; }
+
+  //! Returns an empty slot, from the free list or from the unused end of the slab, which must have room.
+  index take_slot() {
+    if (m_free != sentinel) {
+      index idx = m_free;
+      m_free = m_slots[idx].next;
+      return idx;
+    }
+    return static_cast<index>(m_used++);
+  }
+
+  //! Doubles the slab.
+  void grow() {
+    if (m_capacity == slot_limit) {
+      throw std::length_error("A lista compacta está limitada a 2^32 - 1 elementos");
+    }
+    std::size_t grown = m_capacity < 16 ? 16 : m_capacity * 2;
+    reallocate(grown < slot_limit ? grown : slot_limit);
+  }
+
+  //! Constructs an element in a free slot and links it right before `pos`.
+  template <typename... Args>
+  iterator link_new(const_iterator pos, Args &&...args) {
+    index idx = take_slot();
+    try {
+      ::new (static_cast<void *>(m_slots[idx].storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      give_back(idx);
+      throw;
+    }
+    slot &s = m_slots[idx];
+    slot &at = m_slots[pos.m_idx];
+    s.next = pos.m_idx;
+    s.prev = at.prev;
+    m_slots[at.prev].next = idx;
+    at.prev = idx;
+    ++m_len;
+    return iterator{this, idx};
+  }
+
+  //! Puts an empty slot on the free list.
+  void give_back(index idx) {
+    m_slots[idx].next = m_free;
+    m_free = idx;
+  }
+
+  //! Moves the slab to a new one with `count` slots; every index keeps its meaning.
+  void reallocate(std::size_t count) {
+    slot *bigger = static_cast<slot *>(::operator new(count * sizeof(slot), std::align_val_t{alignof(slot)}));
+    if (m_slots == nullptr) {
+      bigger[sentinel].next = bigger[sentinel].prev = sentinel;
+      m_used = 1;
+    } else {
+      // Links first (free slots included), then the live elements.
+      for (std::size_t i{0}; i < m_used; ++i) {
+        bigger[i].next = m_slots[i].next;
+        bigger[i].prev = m_slots[i].prev;
+      }
+      index i = first_index();
+      try {
+        for (; i != sentinel; i = m_slots[i].next) {
+          ::new (static_cast<void *>(bigger[i].storage)) T(std::move_if_noexcept(*m_slots[i].value()));
+        }
+      } catch (...) {
+        for (index j = first_index(); j != i; j = m_slots[j].next) {
+          bigger[j].value()->~T();
+        }
+        ::operator delete(bigger, std::align_val_t{alignof(slot)});
+        throw;
+      }
+      for (index j = first_index(); j != sentinel; j = m_slots[j].next) {
+        m_slots[j].value()->~T();
+      }
+      ::operator delete(m_slots, std::align_val_t{alignof(slot)});
+    }
+    m_slots = bigger;
+    m_capacity = count;
+  }
+
+  //! Destroys the elements and frees the slab.
+  void release() noexcept {
+    if (m_slots == nullptr) {
+      return;
+    }
+    clear();
+    ::operator delete(m_slots, std::align_val_t{alignof(slot)});
+    m_slots = nullptr;
+    m_capacity = m_used = 0;
+  }
+};
+
+//! Two compact lists are equal if they hold equal elements in the same order.
+template <typename T>
+bool operator==(const compact_list<T> &a, const compact_list<T> &b) {
+  if (a.size() != b.size()) { return false; }
+  auto it = b.cbegin();
+  for (const T &value : a) {
+    if (!(value == *it++)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool operator!=(const compact_list<T> &a, const compact_list<T> &b) {
+  return !(a == b);
+}
+
+} // namespace sc
+#endif
@@ -0,0 +1,74 @@
+#ifndef _EXECUTION_H_
+#define _EXECUTION_H_
+
+#include <cstddef>      // std::size_t
+#include <exception>    // std::exception_ptr
+#include <system_error> // std::system_error
+#include <thread>
+#include <vector>
+
+namespace sc {
+namespace execution {
+
+/*!
+ *  \struct parallel_policy
+ *  \brief Asks an algorithm to spread its work over several threads.
+ *
+ *  Algorithms fall back to their sequential version when the input is
+ *  smaller than `threshold`, since starting threads is not free.
+ */
+struct parallel_policy {
+  std::size_t threshold = 1 << 16; //!< Inputs smaller than this are processed sequentially.
+  unsigned threads = 0;            //!< Number of worker threads; 0 means one per hardware thread.
+
+  //! Returns how many threads should actually be used.
+  unsigned thread_count() const {
+    if (threads != 0) { return threads; }
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : hw;
+  }
+};
+
+//! Default parallel policy, e.g. `list.sort(sc::execution::par)`.
+inline constexpr parallel_policy par{};
+
+} // namespace execution
+
+namespace detail {
+/*!
+ *  Runs `job(0)`, ..., `job(count - 1)` concurrently and waits for all of them.
+ *  Job 0 runs on the calling thread, and so does any job whose thread could not
+ *  be started. An exception thrown by job `i` is stored in `errors[i]`.
+ *
+ *  \param count Number of jobs.
+ *  \param job Callable taking the job index.
+ *  \param errors Must hold `count` entries.
+ */
+template <typename Job>
+void parallel_for(std::size_t count, Job &job, std::vector<std::exception_ptr> &errors) {
+  auto guarded = [&job, &errors](std::size_t i) {
+    try {
+      job(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve(count);
+  for (std::size_t i{1}; i < count; ++i) {
+    try {
+      workers.emplace_back(guarded, i);
+    } catch (const std::system_error &) {
+      guarded(i);
+    }
+  }
+  guarded(0);
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+} // namespace detail
+
+} // namespace sc
+#endif
@@ -0,0 +1,639 @@
+#ifndef _EXPRESS_LIST_H_
+#define _EXPRESS_LIST_H_
+
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <cstdint>          // std::uint32_t, std::uint64_t
+#include <initializer_list>
+#include <iterator>         // bidirectional_iterator_tag
+#include <new>              // operator new, std::align_val_t
+#include <stdexcept>        // std::out_of_range
+#include <type_traits>
+#include <utility>          // std::move, std::forward, std::swap
+
+namespace sc {
+
+/*!
+ *  \class express_list
+ *  \brief Doubly-linked list with express lanes (an indexable skip list) for O(log n) positioning.
+ *
+ *  Level 0 is an ordinary doubly-linked list. Each node also gets a random
+ *  number of express lanes (one more with probability 1/4), and every lane
+ *  link records how many elements it skips. Descending the lanes from the
+ *  head finds the k-th element in O(log n) expected steps; climbing them
+ *  from a node back to the head finds its position just as fast. So
+ *  `nth()`, `at()`, `advance()`, iterator `+=`/`-=`, `rank()`,
+ *  `distance()` and insertion or removal at a position (`insert_at()`,
+ *  `erase_at()`) are O(log n) instead of O(n). Nodes are allocated one by
+ *  one and never move, so iterators stay valid until their element is erased.
+ *
+ *  The price is memory, about 1.3 lanes (24 bytes each) per element on
+ *  average, plus a small constant on every insertion and removal to keep
+ *  the lane widths right.
+ *
+ *  The two sentinels and their lanes live inside the list object, so an
+ *  empty list owns no memory and moving a list never allocates.
+ *
+ *  \tparam T The type of the elements.
+ */
+template <typename T>
+class express_list {
+  struct node_base;
+
+  //! One level of links of a node: its neighbours on that level and the distance to the next one.
+  struct lane {
+    node_base *next;
+    node_base *prev;
+    std::size_t width; //!< Elements from this node to `next`, counting `next` but not this node.
+  };
+
+  //! The part of a node shared with the sentinels. The lanes of a node follow in the same allocation.
+  struct node_base {
+    lane *lanes;
+    std::uint32_t height; //!< Number of lanes; the sentinels have `max_level`.
+  };
+
+  //! An element node.
+  struct Node : node_base {
+    T data;
+
+    template <typename... Args>
+    explicit Node(Args &&...args) : node_base{nullptr, 0}, data(std::forward<Args>(args)...) { }
+  };
+
+  static constexpr std::uint32_t max_level = 32;
+  //! Where the lanes start inside a node allocation.
+  static constexpr std::size_t lanes_offset = (sizeof(Node) + alignof(lane) - 1) / alignof(lane) * alignof(lane);
+  static constexpr std::size_t node_align = alignof(Node) > alignof(lane) ? alignof(Node) : alignof(lane);
+
+  //! A sentinel: every lane, held inline so that it can live inside the list.
+  struct sentinel : node_base {
+    lane links[max_level];
+
+    sentinel() : node_base{links, max_level} { }
+    sentinel(const sentinel &) = delete;
+    sentinel &operator=(const sentinel &) = delete;
+  };
+
+  static Node *as_node(node_base *node) { return static_cast<Node *>(node); }
+
+  static bool is_head(const node_base *node) { return node->lanes[0].prev == nullptr; }
+
+  /*!
+   *  Climbs from `node` to the head along the highest lane of every node on the way.
+   *  \param pos Receives the position of `node`: 0 for the head, i + 1 for the i-th element.
+   *  \return The head.
+   */
+  static node_base *climb(node_base *node, std::size_t &pos) {
+    pos = 0;
+    while (!is_head(node)) {
+      std::uint32_t top = node->height - 1;
+      node_base *prev = node->lanes[top].prev;
+      pos += prev->lanes[top].width;
+      node = prev;
+    }
+    return node;
+  }
+
+  //! Descends the lanes from `head` to the node at position `target` (the tail is at size + 1).
+  static node_base *descend(node_base *head, std::size_t target, std::uint32_t top = max_level) {
+    node_base *node = head;
+    std::size_t pos = 0;
+    for (std::uint32_t level = top; level-- > 0;) {
+      while (node->lanes[level].next != nullptr && pos + node->lanes[level].width <= target) {
+        pos += node->lanes[level].width;
+        node = node->lanes[level].next;
+      }
+    }
+    return node;
+  }
+
+  //! Moves `node` by `step` positions, through the head.
+  static node_base *jump(node_base *node, std::ptrdiff_t step) {
+    std::size_t pos;
+    node_base *head = climb(node, pos);
+    return descend(head, static_cast<std::size_t>(static_cast<std::ptrdiff_t>(pos) + step));
+  }
+
+  /*!
+   *  \class iterator_impl
+   *  \brief Bidirectional iterator over an express list; `+=` and `-=` take O(log n).
+   *  \tparam Const Whether this iterator gives read-only access.
+   */
+  template <bool Const>
+  class iterator_impl {
+  public:
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+  private:
+    node_base *m_ptr; //!< The current node.
+
+  public:
+    iterator_impl(node_base *ptr = nullptr) : m_ptr{ptr} { }
+
+    //! A mutable iterator converts to a const one.
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    iterator_impl(const iterator_impl<false> &other) : m_ptr{other.m_ptr} { }
+
+    reference operator*() const { return as_node(m_ptr)->data; }
+    pointer operator->() const { return &as_node(m_ptr)->data; }
+
+    iterator_impl &operator++() {
+      m_ptr = m_ptr->lanes[0].next;
+      return *this;
+    }
+
+    iterator_impl operator++(int) {
+      iterator_impl temp{*this};
+      ++*this;
+      return temp;
+    }
+
+    iterator_impl &operator--() {
+      m_ptr = m_ptr->lanes[0].prev;
+      return *this;
+    }
+
+    iterator_impl operator--(int) {
+      iterator_impl temp{*this};
+      --*this;
+      return temp;
+    }
+
+    /*!
+     *  Advances the iterator by `step` positions (backwards if negative), in O(log n).
+     *  The result must lie between begin() and end().
+     */
+    iterator_impl &operator+=(difference_type step) {
+      m_ptr = jump(m_ptr, step);
+      return *this;
+    }
+
+    //! Moves the iterator back by `step` positions, in O(log n).
+    iterator_impl &operator-=(difference_type step) { return *this += -step; }
+
+    iterator_impl operator+(difference_type step) const { return iterator_impl{*this} += step; }
+    iterator_impl operator-(difference_type step) const { return iterator_impl{*this} -= step; }
+
+    //! Number of steps from `rhs` to this iterator (negative if this one comes first), in O(log n).
+    difference_type operator-(const iterator_impl &rhs) const {
+      std::size_t here, there;
+      climb(m_ptr, here);
+      climb(rhs.m_ptr, there);
+      return static_cast<difference_type>(here) - static_cast<difference_type>(there);
+    }
+
+    bool operator==(const iterator_impl &rhs) const { return m_ptr == rhs.m_ptr; }
+    bool operator!=(const iterator_impl &rhs) const { return m_ptr != rhs.m_ptr; }
+
+    friend class express_list;
+    friend class iterator_impl<!Const>;
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = iterator_impl<false>;      //!< Mutable iterator.
+  using const_iterator = iterator_impl<true>; //!< Read-only iterator.
+
+  //=== [I] Special members
+  //! \brief Constructs an empty list.
+  express_list() { reset_sentinels(); }
+
+  //! \brief Constructs a list with the elements of [first, last).
+  template <typename InputIt>
+  express_list(InputIt first, InputIt last) : express_list() {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  //! \brief Constructs a list with the elements of an initializer list.
+  express_list(std::initializer_list<T> ilist_) : express_list(ilist_.begin(), ilist_.end()) { }
+
+  express_list(const express_list &other) : express_list(other.cbegin(), other.cend()) { }
+
+  //! \brief Takes over the nodes of `other`, which is left empty.
+  express_list(express_list &&other) noexcept : express_list() { swap(other); }
+
+  express_list &operator=(const express_list &rhs) {
+    if (this != &rhs) {
+      express_list temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  //! \brief Releases the current elements and takes over those of `rhs`, which is left empty.
+  express_list &operator=(express_list &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  ~express_list() { clear(); }
+
+  //! Exchanges the lanes of the sentinels, then points the first and last node of every lane at their new sentinels.
+  void swap(express_list &other) noexcept {
+    for (std::uint32_t level{0}; level < max_level; ++level) {
+      std::swap(m_head.links[level], other.m_head.links[level]);
+      std::swap(m_tail.links[level], other.m_tail.links[level]);
+    }
+    adopt_lanes();
+    other.adopt_lanes();
+    std::swap(m_len, other.m_len);
+    std::swap(m_level, other.m_level);
+    std::swap(m_seed, other.m_seed);
+  }
+
+  //=== [II] Iterators
+  iterator begin() { return iterator{m_head.links[0].next}; }
+  iterator end() { return iterator{tail()}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_iterator cbegin() const { return const_iterator{m_head.links[0].next}; }
+  const_iterator cend() const { return const_iterator{tail()}; }
+
+  //=== [III] Capacity/Status
+  [[nodiscard]] bool empty() const { return m_len == 0; }
+  [[nodiscard]] size_type size() const { return m_len; }
+
+  //=== [IV] Access
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &front() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *begin();
+  }
+
+  const T &front() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *cbegin();
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &back() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *--end();
+  }
+
+  const T &back() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *--cend();
+  }
+
+  /*!
+   *  Returns an iterator to the element at position `index` (end() if `index == size()`), in O(log n).
+   *  \throw std::out_of_range if `index > size()`.
+   */
+  iterator nth(size_type index) {
+    check_position(index);
+    return iterator{descend(head(), index + 1, m_level)};
+  }
+
+  const_iterator nth(size_type index) const {
+    check_position(index);
+    return const_iterator{descend(head(), index + 1, m_level)};
+  }
+
+  /*!
+   *  Returns `it` moved by `step` positions (backwards if negative), in O(log n).
+   *  \throw std::out_of_range if the result would fall outside [begin(), end()].
+   */
+  iterator advance(const_iterator it, difference_type step) {
+    std::size_t pos;
+    climb(it.m_ptr, pos);
+    difference_type target = static_cast<difference_type>(pos) + step;
+    if (target < 1 || target > static_cast<difference_type>(m_len + 1)) {
+      throw std::out_of_range("Posição fora da lista");
+    }
+    return iterator{descend(head(), static_cast<std::size_t>(target), m_level)};
+  }
+
+  /*!
+   *  Returns the element at position `index`, in O(log n).
+   *  \throw std::out_of_range if `index >= size()`.
+   */
+  T &at(size_type index) {
+    check_index(index);
+    return *nth(index);
+  }
+
+  const T &at(size_type index) const {
+    check_index(index);
+    return *nth(index);
+  }
+
+  //! Returns the position of the element at `it` (size() for end()), in O(log n).
+  size_type rank(const_iterator it) const {
+    std::size_t pos;
+    climb(it.m_ptr, pos);
+    return pos - 1;
+  }
+
+  //! Returns how many steps lead from `first` to `last` (negative if `last` comes first), in O(log n).
+  difference_type distance(const_iterator first, const_iterator last) const { return last - first; }
+
+  //=== [V] Modifiers
+  //! Removes all elements from the list.
+  void clear() {
+    node_base *node = m_head.links[0].next;
+    while (node != tail()) {
+      node_base *next = node->lanes[0].next;
+      destroy_node(as_node(node));
+      node = next;
+    }
+    reset_sentinels();
+    m_len = 0;
+    m_level = 1;
+  }
+
+  void push_front(const T &value_) { emplace(cbegin(), value_); }
+  void push_front(T &&value_) { emplace(cbegin(), std::move(value_)); }
+  void push_back(const T &value_) { emplace(cend(), value_); }
+  void push_back(T &&value_) { emplace(cend(), std::move(value_)); }
+
+  template <typename... Args>
+  T &emplace_front(Args &&...args) { return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args) { return *emplace(cend(), std::forward<Args>(args)...); }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_front() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(cbegin());
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_back() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(--cend());
+  }
+
+  /*!
+   *  Constructs a new element right before `pos`, in O(log n).
+   *  \return An iterator to the new element.
+   */
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    Node *node = create_node(random_height(), std::forward<Args>(args)...);
+    link_before(pos.m_ptr, node);
+    return iterator{node};
+  }
+
+  iterator insert(const_iterator pos, const T &value_) { return emplace(pos, value_); }
+  iterator insert(const_iterator pos, T &&value_) { return emplace(pos, std::move(value_)); }
+
+  /*!
+   *  Inserts the elements of [first, last) right before `pos`.
+   *  \return An iterator to the first inserted element, or `pos` if the range is empty.
+   */
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    iterator result{pos.m_ptr};
+    bool first_one = true;
+    for (; first != last; ++first) {
+      iterator it = emplace(pos, *first);
+      if (first_one) {
+        result = it;
+        first_one = false;
+      }
+    }
+    return result;
+  }
+
+  /*!
+   *  Inserts `value_` so that it ends up at position `index`, in O(log n).
+   *  \return An iterator to the new element.
+   *  \throw std::out_of_range if `index > size()`.
+   */
+  iterator insert_at(size_type index, const T &value_) { return emplace(nth(index), value_); }
+  iterator insert_at(size_type index, T &&value_) { return emplace(nth(index), std::move(value_)); }
+
+  /*!
+   *  Removes the element at position `index`, in O(log n).
+   *  \return An iterator to the element that followed it.
+   *  \throw std::out_of_range if `index >= size()`.
+   */
+  iterator erase_at(size_type index) {
+    check_index(index);
+    return erase(nth(index));
+  }
+
+  /*!
+   *  Removes the element at `pos`, in O(log n).
+   *  \return An iterator to the element that followed it.
+   */
+  iterator erase(const_iterator pos) {
+    node_base *next = pos.m_ptr->lanes[0].next;
+    unlink(pos.m_ptr);
+    destroy_node(as_node(pos.m_ptr));
+    return iterator{next};
+  }
+
+  //! Removes the elements of [first, last).
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator{last.m_ptr};
+  }
+
+  //=== [VI] Operations
+  //! Finds the first element equal to `value_`, or returns end().
+  iterator find(const T &value_) {
+    iterator it = begin();
+    while (it != end() && !(*it == value_)) {
+      ++it;
+    }
+    return it;
+  }
+
+  const_iterator find(const T &value_) const {
+    const_iterator it = cbegin();
+    while (it != cend() && !(*it == value_)) {
+      ++it;
+    }
+    return it;
+  }
+
+private:
+  sentinel m_head;                //!< Sentinel at position 0.
+  sentinel m_tail;                //!< Sentinel at position size() + 1.
+  size_type m_len{0};
+  std::uint32_t m_level{1};       //!< Lanes worth searching: no element is taller.
+  std::uint64_t m_seed{0x9E3779B97F4A7C15ull}; //!< State of the height generator.
+
+  void check_index(size_type index) const {
+    if (index >= m_len) {
+      throw std::out_of_range("Índice fora da lista");
+    }
+  }
+
+  void check_position(size_type index) const {
+    if (index > m_len) {
+      throw std::out_of_range("Posição fora da lista");
+    }
+  }
+
+  //! 1 plus a geometric variable with p = 3/4: each extra lane has probability 1/4.
+  std::uint32_t random_height() {
+    // xorshift64*
+    m_seed ^= m_seed >> 12;
+    m_seed ^= m_seed << 25;
+    m_seed ^= m_seed >> 27;
+    std::uint64_t bits = m_seed * 0x2545F4914F6CDD1Dull;
+    std::uint32_t height = 1;
+    while (height < max_level - 1 && (bits & 3) == 0) {
+      ++height;
+      bits >>= 2;
+    }
+    return height;
+  }
+
+  node_base *head() const { return const_cast<sentinel *>(&m_head); }
+  node_base *tail() const { return const_cast<sentinel *>(&m_tail); }
+
+  //! Links the two sentinels to each other on every lane.
+  void reset_sentinels() {
+    for (std::uint32_t level{0}; level < max_level; ++level) {
+      m_head.links[level] = lane{tail(), nullptr, 1};
+      m_tail.links[level] = lane{nullptr, head(), 0};
+    }
+  }
+
+  /*!
+   *  After the sentinels' lanes were exchanged with another list's, makes the
+   *  nodes they reach point back at these sentinels. A lane that reaches the
+   *  other list's sentinel was empty, so it is closed on these sentinels.
+   */
+  void adopt_lanes() noexcept {
+    for (std::uint32_t level{0}; level < max_level; ++level) {
+      lane &first = m_head.links[level];
+      if (first.next->lanes[0].next == nullptr) { // A tail: the lane is empty.
+        first.next = tail();
+        m_tail.links[level].prev = head();
+        continue;
+      }
+      first.next->lanes[level].prev = head();
+      m_tail.links[level].prev->lanes[level].next = tail();
+    }
+  }
+
+  /*!
+   *  Finds, for every level, the last node before `node` that reaches that
+   *  level, and how far behind `node` it is.
+   */
+  static void locate(node_base *node, node_base **update, std::size_t *dist) {
+    node_base *z = node->lanes[0].prev;
+    std::size_t d = 1;
+    for (std::uint32_t level{0}; level < max_level; ++level) {
+      while (z->height <= level) {
+        std::uint32_t top = z->height - 1;
+        node_base *prev = z->lanes[top].prev;
+        d += prev->lanes[top].width;
+        z = prev;
+      }
+      update[level] = z;
+      dist[level] = d;
+    }
+  }
+
+  //! Links the unlinked `node` right before `pos` on all its lanes and widens the links passing over it.
+  void link_before(node_base *pos, node_base *node) {
+    node_base *update[max_level];
+    std::size_t dist[max_level];
+    locate(pos, update, dist);
+    for (std::uint32_t level{0}; level < max_level; ++level) {
+      lane &left = update[level]->lanes[level];
+      if (level < node->height) {
+        node_base *next = left.next;
+        node->lanes[level] = lane{next, update[level], left.width - dist[level] + 1};
+        left.width = dist[level];
+        left.next = node;
+        next->lanes[level].prev = node;
+      } else {
+        ++left.width;
+      }
+    }
+    if (node->height > m_level) {
+      m_level = node->height;
+    }
+    ++m_len;
+  }
+
+  //! Takes `node` off all its lanes and narrows the links that passed over it.
+  void unlink(node_base *node) {
+    std::uint32_t height = node->height;
+    for (std::uint32_t level{0}; level < height; ++level) {
+      lane &own = node->lanes[level];
+      lane &left = own.prev->lanes[level];
+      left.width += own.width - 1;
+      left.next = own.next;
+      own.next->lanes[level].prev = own.prev;
+    }
+    node_base *z = node->lanes[height - 1].prev;
+    for (std::uint32_t level = height; level < max_level; ++level) {
+      while (z->height <= level) {
+        z = z->lanes[z->height - 1].prev;
+      }
+      --z->lanes[level].width;
+    }
+    --m_len;
+  }
+
+  template <typename... Args>
+  Node *create_node(std::uint32_t height, Args &&...args) {
+    void *raw = ::operator new(lanes_offset + height * sizeof(lane), std::align_val_t{node_align});
+    Node *node;
+    try {
+      node = ::new (raw) Node(std::forward<Args>(args)...);
+    } catch (...) {
+      ::operator delete(raw, std::align_val_t{node_align});
+      throw;
+    }
+    node->lanes = reinterpret_cast<lane *>(static_cast<unsigned char *>(raw) + lanes_offset);
+    node->height = height;
+    return node;
+  }
+
+  void destroy_node(Node *node) {
+    node->~Node();
+    ::operator delete(static_cast<void *>(node), std::align_val_t{node_align});
+  }
+};
+
+//! Two express lists are equal if they hold equal elements in the same order.
+template <typename T>
+bool operator==(const express_list<T> &a, const express_list<T> &b) {
+  if (a.size() != b.size()) { return false; }
+  auto it = b.cbegin();
+  for (const T &value : a) {
+    if (!(value == *it++)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool operator!=(const express_list<T> &a, const express_list<T> &b) {
+  return !(a == b);
+}
+
+} // namespace sc
+#endif
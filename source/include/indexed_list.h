@@ -0,0 +1,406 @@
+#ifndef _INDEXED_LIST_H_
+#define _INDEXED_LIST_H_
+
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint64_t
+#include <functional>       // std::hash, std::equal_to
+#include <initializer_list>
+#include <utility>          // std::move, std::forward, std::swap
+#include <vector>
+
+#include "list.h"
+
+namespace sc {
+
+//! Default key projection of `indexed_list`: the element itself is the key.
+struct identity_key {
+  template <typename U>
+  const U &operator()(const U &value) const noexcept { return value; }
+};
+
+/*!
+ *  \class indexed_list
+ *  \brief An `sc::list` paired with a hash index from key to node, for O(1) average lookups.
+ *
+ *  Iteration follows the list order (insertion order unless the list is
+ *  reordered), while `find`, `contains`, `count` and `erase(key)` go through
+ *  an open-addressing table (linear probing) of list iterators. The index
+ *  follows every operation that adds or removes nodes: `push_*`, `emplace*`,
+ *  `insert`, `erase`, `pop_*`, `clear`, `splice` and `merge`. Operations that
+ *  only reorder nodes (`sort`, `reverse`) leave it untouched.
+ *
+ *  Several elements may share a key; `find` then returns one of them.
+ *  Elements are only reachable as `const`, since changing a key in place would
+ *  leave the index pointing at the wrong slot: erase and re-insert instead.
+ *
+ *  \tparam T The type of the elements.
+ *  \tparam KeyOf Projection from an element to its key (the element itself by default).
+ *  \tparam Hash Hash function of the keys.
+ *  \tparam KeyEqual Equality of the keys.
+ *  \tparam Alloc The allocator used for the list nodes.
+ */
+template <typename T, typename KeyOf = identity_key,
+          typename Hash = std::hash<std::decay_t<decltype(KeyOf{}(std::declval<const T &>()))>>,
+          typename KeyEqual = std::equal_to<>, typename Alloc = sc::pool_allocator<T>>
+class indexed_list {
+  using list_type = sc::list<T, Alloc>;
+  using node_iterator = typename list_type::const_iterator;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using key_type = std::decay_t<decltype(KeyOf{}(std::declval<const T &>()))>;
+  using iterator = node_iterator;       //!< Elements are read-only, see the class notes.
+  using const_iterator = node_iterator; //!< Read-only iterator.
+
+  //=== [I] Special members
+  //! \brief Constructs an empty list.
+  indexed_list() = default;
+
+  //! \brief Constructs a list with the elements of [first, last).
+  template <typename InputIt>
+  indexed_list(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+
+  //! \brief Constructs a list with the elements of an initializer list.
+  indexed_list(std::initializer_list<T> ilist_) : indexed_list(ilist_.begin(), ilist_.end()) { }
+
+  //! \brief Copies the elements of `other` and builds a new index for them.
+  indexed_list(const indexed_list &other) : indexed_list(other.cbegin(), other.cend()) { }
+
+  //! \brief Takes over the elements and the index of `other`, which is left empty.
+  indexed_list(indexed_list &&other) noexcept { swap(other); }
+
+  indexed_list &operator=(const indexed_list &rhs) {
+    if (this != &rhs) {
+      indexed_list temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  indexed_list &operator=(indexed_list &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  void swap(indexed_list &other) noexcept {
+    m_list.swap(other.m_list);
+    m_slots.swap(other.m_slots);
+  }
+
+  //=== [II] Iterators
+  const_iterator begin() const { return m_list.cbegin(); }
+  const_iterator end() const { return m_list.cend(); }
+  const_iterator cbegin() const { return m_list.cbegin(); }
+  const_iterator cend() const { return m_list.cend(); }
+
+  //=== [III] Capacity/Status
+  [[nodiscard]] bool empty() const { return m_list.empty(); }
+  [[nodiscard]] size_type size() const { return m_list.size(); }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  const T &front() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *cbegin();
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  const T &back() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *std::prev(cend());
+  }
+
+  //=== [IV] Lookup
+  /*!
+   *  Finds an element whose key is equal to `key`, in O(1) on average.
+   *  \return An iterator to the element, or end() if there is none.
+   */
+  const_iterator find(const key_type &key) const {
+    if (m_slots.empty()) { return cend(); }
+    std::size_t hash = hash_of(key);
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+      const slot &s = m_slots[i];
+      if (!s.used()) { return cend(); }
+      // The cached hash spares a visit to the node on most mismatches.
+      if (s.hash == hash && KeyEqual{}(KeyOf{}(*s.node), key)) { return s.node; }
+    }
+  }
+
+  //! Returns true if some element has the key `key`.
+  bool contains(const key_type &key) const { return find(key) != cend(); }
+
+  //! Returns how many elements have the key `key`.
+  size_type count(const key_type &key) const {
+    size_type total{0};
+    if (m_slots.empty()) { return total; }
+    std::size_t hash = hash_of(key);
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = hash & mask; m_slots[i].used(); i = (i + 1) & mask) {
+      if (m_slots[i].hash == hash && KeyEqual{}(KeyOf{}(*m_slots[i].node), key)) { ++total; }
+    }
+    return total;
+  }
+
+  //=== [V] Modifiers
+  //! Removes every element and empties the index.
+  void clear() {
+    m_list.clear();
+    m_slots.clear();
+  }
+
+  void push_front(const T &value_) { emplace(cbegin(), value_); }
+  void push_front(T &&value_) { emplace(cbegin(), std::move(value_)); }
+  void push_back(const T &value_) { emplace(cend(), value_); }
+  void push_back(T &&value_) { emplace(cend(), std::move(value_)); }
+
+  template <typename... Args>
+  const T &emplace_front(Args &&...args) { return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+  template <typename... Args>
+  const T &emplace_back(Args &&...args) { return *emplace(cend(), std::forward<Args>(args)...); }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_front() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(cbegin());
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_back() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(std::prev(cend()));
+  }
+
+  /*!
+   *  Constructs a new element right before `pos` and indexes it.
+   *  \return An iterator to the new element.
+   */
+  template <typename... Args>
+  const_iterator emplace(const_iterator pos, Args &&...args) {
+    reserve_index(size() + 1); // The only step that may fail after the node exists is hashing.
+    node_iterator node = m_list.emplace(pos, std::forward<Args>(args)...);
+    try {
+      index(node);
+    } catch (...) {
+      m_list.erase(node);
+      throw;
+    }
+    return node;
+  }
+
+  const_iterator insert(const_iterator pos, const T &value_) { return emplace(pos, value_); }
+  const_iterator insert(const_iterator pos, T &&value_) { return emplace(pos, std::move(value_)); }
+
+  /*!
+   *  Inserts the elements of [first, last) right before `pos`.
+   *  \return An iterator to the first inserted element, or `pos` if the range is empty.
+   */
+  template <typename InputIt>
+  const_iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    const_iterator result = pos;
+    bool first_one = true;
+    for (; first != last; ++first) {
+      const_iterator it = emplace(pos, *first);
+      if (first_one) {
+        result = it;
+        first_one = false;
+      }
+    }
+    return result;
+  }
+
+  //! Removes the element at `pos` from the index and the list.
+  const_iterator erase(const_iterator pos) {
+    unindex(pos);
+    return m_list.erase(pos);
+  }
+
+  //! Removes the elements of [first, last).
+  const_iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    return last;
+  }
+
+  /*!
+   *  Removes every element whose key is equal to `key`.
+   *  \return The number of elements removed.
+   */
+  size_type erase(const key_type &key) {
+    size_type removed{0};
+    for (const_iterator it = find(key); it != cend(); it = find(key)) {
+      erase(it);
+      ++removed;
+    }
+    return removed;
+  }
+
+  //=== [VI] Operations
+  //! Moves all the elements of `other` right before `pos`; their index entries move too.
+  void splice(const_iterator pos, indexed_list &other) {
+    if (this == &other || other.empty()) {
+      return;
+    }
+    adopt_index(other, other.cbegin(), other.cend());
+    m_list.splice(pos, other.m_list);
+  }
+
+  //! Moves the element at `it` from `other` to right before `pos`.
+  void splice(const_iterator pos, indexed_list &other, const_iterator it) {
+    if (this != &other) {
+      adopt_index(other, it, std::next(it));
+    }
+    m_list.splice(pos, other.m_list, it);
+  }
+
+  //! Moves the elements of [first, last) from `other` to right before `pos`.
+  void splice(const_iterator pos, indexed_list &other, const_iterator first, const_iterator last) {
+    if (this != &other) {
+      adopt_index(other, first, last);
+    }
+    m_list.splice(pos, other.m_list, first, last);
+  }
+
+  //! Merges the sorted list `other` into this sorted list; the index entries of `other` move too.
+  void merge(indexed_list &other) {
+    if (this == &other || other.empty()) {
+      return;
+    }
+    adopt_index(other, other.cbegin(), other.cend());
+    m_list.merge(other.m_list);
+  }
+
+  //! Sorts the elements with `<`; the index is not affected.
+  void sort() { m_list.sort(); }
+
+  //! Reverses the order of the elements; the index is not affected.
+  void reverse() { m_list.reverse(); }
+
+private:
+  //! A table slot: the node of one element, plus its cached hash.
+  struct slot {
+    node_iterator node{};
+    std::size_t hash{0};
+    bool used() const { return node != node_iterator{}; }
+  };
+
+  list_type m_list;          //!< The elements, in order.
+  std::vector<slot> m_slots; //!< Open-addressing table; its size is zero or a power of two.
+
+  /*!
+   *  Scrambles the user hash, whose low bits pick the slot. Hashes such as
+   *  `std::hash<int>` return the key itself, and runs of consecutive keys
+   *  would otherwise fill runs of consecutive slots, making probes long.
+   */
+  static std::size_t hash_of(const key_type &key) {
+    std::uint64_t h = static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+    return static_cast<std::size_t>(h ^ (h >> 32));
+  }
+
+  //! Grows the table so that `count` entries keep the load factor at or below 3/4.
+  void reserve_index(size_type count) {
+    if (count * 4 <= m_slots.size() * 3) {
+      return;
+    }
+    std::size_t capacity = m_slots.empty() ? 16 : m_slots.size();
+    while (count * 4 > capacity * 3) {
+      capacity *= 2;
+    }
+    std::vector<slot> bigger(capacity);
+    for (const slot &s : m_slots) {
+      if (s.used()) {
+        place(bigger, s);
+      }
+    }
+    m_slots.swap(bigger);
+  }
+
+  //! Puts `s` in the first free slot of its probe sequence.
+  static void place(std::vector<slot> &slots, const slot &s) {
+    std::size_t mask = slots.size() - 1;
+    std::size_t i = s.hash & mask;
+    while (slots[i].used()) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = s;
+  }
+
+  //! Adds a node to the index; the table must already have room for it.
+  void index(node_iterator node) {
+    place(m_slots, slot{node, hash_of(KeyOf{}(*node))});
+  }
+
+  //! Removes a node from the index, shifting back the entries that probed past it.
+  void unindex(node_iterator node) {
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = hash_of(KeyOf{}(*node)) & mask;
+    while (m_slots[i].node != node) {
+      if (!m_slots[i].used()) {
+        return; // Not indexed: an empty slot ends the probe, as in `lookup`.
+      }
+      i = (i + 1) & mask;
+    }
+    // Backward-shift deletion: no tombstones, so lookups never slow down.
+    for (std::size_t j = (i + 1) & mask; m_slots[j].used(); j = (j + 1) & mask) {
+      std::size_t home = m_slots[j].hash & mask;
+      // Move `j` into the hole unless its home lies cyclically in (i, j].
+      bool stays = i <= j ? (i < home && home <= j) : (i < home || home <= j);
+      if (!stays) {
+        m_slots[i] = m_slots[j];
+        i = j;
+      }
+    }
+    m_slots[i] = slot{};
+  }
+
+  //! Moves the index entries of [first, last) from `other` to this list.
+  void adopt_index(indexed_list &other, const_iterator first, const_iterator last) {
+    size_type count{0};
+    for (auto it = first; it != last; ++it) {
+      ++count;
+    }
+    reserve_index(size() + count);
+    for (auto it = first; it != last; ++it) {
+      other.unindex(it);
+      index(it);
+    }
+  }
+};
+
+//! Two indexed lists are equal if they hold equal elements in the same order.
+template <typename T, typename K, typename H, typename E, typename A>
+bool operator==(const indexed_list<T, K, H, E, A> &a, const indexed_list<T, K, H, E, A> &b) {
+  if (a.size() != b.size()) { return false; }
+  auto it = b.cbegin();
+  for (const T &value : a) {
+    if (!(value == *it++)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename K, typename H, typename E, typename A>
+bool operator!=(const indexed_list<T, K, H, E, A> &a, const indexed_list<T, K, H, E, A> &b) {
+  return !(a == b);
+}
+
+} // namespace sc
+#endif
@@ -0,0 +1,427 @@
+#ifndef _INTRUSIVE_LIST_H_
+#define _INTRUSIVE_LIST_H_
+
+#include <cassert>     // assert()
+#include <cstddef>     // std::size_t, std::ptrdiff_t
+#include <functional>  // std::less
+#include <iterator>    // bidirectional_iterator_tag
+#include <stdexcept>   // std::out_of_range
+#include <type_traits>
+#include <utility>     // std::swap
+
+#include "list_links.h"
+
+namespace sc {
+
+/*!
+ *  \struct list_hook
+ *  \brief The links an object embeds to be stored in an `intrusive_list`.
+ *
+ *  An object needs one hook per list it may be on at the same time. Copying
+ *  an object never copies its links: the copy starts out unlinked.
+ */
+struct list_hook {
+  list_hook *next = nullptr; //!< Pointer to the next hook.
+  list_hook *prev = nullptr; //!< Pointer to the previous hook.
+
+  list_hook() = default;
+  list_hook(const list_hook &) noexcept { /* empty */ }
+  list_hook &operator=(const list_hook &) noexcept { return *this; }
+
+  //! Returns true if the hook is currently on a list.
+  bool is_linked() const noexcept { return next != nullptr; }
+};
+
+/*!
+ *  \class intrusive_list
+ *  \brief Doubly-linked list of caller-owned objects, linked through an embedded `list_hook`.
+ *
+ *  Offers the iterator, `insert`, `erase`, `splice` and `merge` API of
+ *  `sc::list`, but the list never allocates, copies or destroys an element:
+ *  it only links and unlinks the objects it is given, which must outlive
+ *  their stay on the list. Since the links live in the object,
+ *  `iterator_to()` and `erase(T&)` find and unlink an element in O(1).
+ *
+ *  \code
+ *  struct job { int id; sc::list_hook by_queue; sc::list_hook by_owner; };
+ *  sc::intrusive_list<job, &job::by_queue> queue;
+ *  sc::intrusive_list<job, &job::by_owner> owned;
+ *  \endcode
+ *
+ *  \tparam T The type of the objects stored in the list.
+ *  \tparam Hook The member of `T` holding the links used by this list.
+ */
+template <typename T, list_hook T::*Hook>
+class intrusive_list {
+private:
+  //! The hook of an element.
+  static list_hook *hook_of(T &value) { return &(value.*Hook); }
+
+  //! The element owning a hook; only valid for hooks that are not the sentinels.
+  static T *owner_of(list_hook *hook) {
+    // The offset of the hook inside T, measured once on a suitably aligned buffer.
+    static const std::ptrdiff_t offset = [] {
+      alignas(T) static unsigned char probe[sizeof(T)];
+      T *fake = reinterpret_cast<T *>(probe);
+      return reinterpret_cast<unsigned char *>(&(fake->*Hook)) - probe;
+    }();
+    return reinterpret_cast<T *>(reinterpret_cast<unsigned char *>(hook) - offset);
+  }
+
+  /*!
+   *  \class iterator_impl
+   *  \brief Bidirectional iterator over an intrusive list.
+   *  \tparam Const Whether this iterator gives read-only access.
+   */
+  template <bool Const>
+  class iterator_impl {
+  public:
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+  private:
+    list_hook *m_ptr; //!< The hook of the current element.
+
+  public:
+    iterator_impl(list_hook *ptr = nullptr) : m_ptr{ptr} { }
+
+    //! A mutable iterator converts to a const one.
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    iterator_impl(const iterator_impl<false> &other) : m_ptr{other.m_ptr} { }
+
+    reference operator*() const { return *owner_of(m_ptr); }
+    pointer operator->() const { return owner_of(m_ptr); }
+
+    iterator_impl &operator++() {
+      m_ptr = m_ptr->next;
+      return *this;
+    }
+
+    iterator_impl operator++(int) {
+      iterator_impl temp{*this};
+      m_ptr = m_ptr->next;
+      return temp;
+    }
+
+    iterator_impl &operator--() {
+      m_ptr = m_ptr->prev;
+      return *this;
+    }
+
+    iterator_impl operator--(int) {
+      iterator_impl temp{*this};
+      m_ptr = m_ptr->prev;
+      return temp;
+    }
+
+    bool operator==(const iterator_impl &rhs) const { return m_ptr == rhs.m_ptr; }
+    bool operator!=(const iterator_impl &rhs) const { return m_ptr != rhs.m_ptr; }
+
+    friend class intrusive_list;
+    friend class iterator_impl<!Const>;
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = iterator_impl<false>;      //!< Mutable iterator.
+  using const_iterator = iterator_impl<true>; //!< Read-only iterator.
+
+  //=== [I] Special members
+  //! \brief Constructs an empty list.
+  intrusive_list() : m_len{0} {
+    init_sentinels();
+  }
+
+  //! \brief Takes over the elements of `other`, which is left empty.
+  intrusive_list(intrusive_list &&other) noexcept : intrusive_list() {
+    swap(other);
+  }
+
+  //! \brief Unlinks the current elements and takes over those of `rhs`.
+  intrusive_list &operator=(intrusive_list &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  // An object can be on a single list per hook, so lists cannot be copied.
+  intrusive_list(const intrusive_list &) = delete;
+  intrusive_list &operator=(const intrusive_list &) = delete;
+
+  //! Unlinks every element; the elements themselves are untouched.
+  ~intrusive_list() {
+    clear();
+  }
+
+  /*!
+   *  Swaps the contents of two lists.
+   *  \param other The other list to swap with.
+   */
+  void swap(intrusive_list &other) noexcept {
+    list_hook *first = empty() ? nullptr : m_head.next;
+    list_hook *last = m_tail.prev;
+    list_hook *other_first = other.empty() ? nullptr : other.m_head.next;
+    list_hook *other_last = other.m_tail.prev;
+    hang_chain(other_first, other_last);
+    other.hang_chain(first, last);
+    std::swap(m_len, other.m_len);
+  }
+
+  //=== [II] Iterators
+  iterator begin() { return iterator{m_head.next}; }
+  iterator end() { return iterator{&m_tail}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_iterator cbegin() const { return const_iterator{m_head.next}; }
+  const_iterator cend() const { return const_iterator{const_cast<list_hook *>(&m_tail)}; }
+
+  /*!
+   *  Returns an iterator to an element that is on this list, in O(1).
+   *  \param value An element currently linked into this list.
+   *  \return An iterator pointing to `value`.
+   */
+  iterator iterator_to(T &value) {
+    assert(hook_of(value)->is_linked());
+    return iterator{hook_of(value)};
+  }
+
+  //=== [III] Capacity/Status
+  [[nodiscard]] bool empty() const { return m_len == 0; }
+  [[nodiscard]] size_type size() const { return m_len; }
+
+  //=== [IV] Access
+  /*!
+   *  Returns the first element.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &front() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *owner_of(m_head.next);
+  }
+
+  /*!
+   *  Returns the last element.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &back() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *owner_of(m_tail.prev);
+  }
+
+  //=== [V] Modifiers
+  //! Unlinks every element.
+  void clear() {
+    list_hook *runner = m_head.next;
+    while (runner != &m_tail) {
+      list_hook *next = runner->next;
+      runner->next = runner->prev = nullptr;
+      runner = next;
+    }
+    init_sentinels();
+    m_len = 0;
+  }
+
+  //! Links `value` at the beginning of the list.
+  void push_front(T &value) { insert(cbegin(), value); }
+
+  //! Links `value` at the end of the list.
+  void push_back(T &value) { insert(cend(), value); }
+
+  /*!
+   *  Unlinks the first element.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_front() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(cbegin());
+  }
+
+  /*!
+   *  Unlinks the last element.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_back() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(const_iterator{m_tail.prev});
+  }
+
+  /*!
+   *  Links `value` right before `pos`.
+   *  \param pos Position in this list.
+   *  \param value An element that is not on any list through this hook.
+   *  \return An iterator pointing to `value`.
+   */
+  iterator insert(const_iterator pos, T &value) {
+    list_hook *hook = hook_of(value);
+    assert(!hook->is_linked());
+    detail::link_before(pos.m_ptr, hook);
+    ++m_len;
+    return iterator{hook};
+  }
+
+  /*!
+   *  Links the elements of [first, last) right before `pos`, in order.
+   *  \param pos Position in this list.
+   *  \param first, last A range of lvalues of `T`, none of them linked through this hook.
+   *  \return An iterator pointing to the first linked element, or `pos` if the range is empty.
+   */
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    iterator result{pos.m_ptr};
+    bool first_one = true;
+    for (; first != last; ++first) {
+      iterator it = insert(pos, *first);
+      if (first_one) {
+        result = it;
+        first_one = false;
+      }
+    }
+    return result;
+  }
+
+  /*!
+   *  Unlinks the element at `pos`.
+   *  \return An iterator to the element that followed it.
+   */
+  iterator erase(const_iterator pos) {
+    list_hook *hook = pos.m_ptr;
+    list_hook *next = hook->next;
+    detail::unlink(hook);
+    hook->next = hook->prev = nullptr;
+    --m_len;
+    return iterator{next};
+  }
+
+  /*!
+   *  Unlinks the elements of [first, last).
+   *  \return An iterator equal to `last`.
+   */
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator{last.m_ptr};
+  }
+
+  /*!
+   *  Unlinks `value` from this list in O(1), without searching for it.
+   *  \param value An element currently linked into this list.
+   *  \return An iterator to the element that followed it.
+   */
+  iterator erase(T &value) { return erase(const_iterator{iterator_to(value)}); }
+
+  //=== [VI] Operations
+  /*!
+   *  Moves all the elements of `other` right before `pos`, in O(1).
+   *  \param pos Position in this list.
+   *  \param other The list to take the elements from; it is left empty.
+   */
+  void splice(const_iterator pos, intrusive_list &other) {
+    if (this == &other || other.empty()) {
+      return;
+    }
+    detail::transfer(pos.m_ptr, other.m_head.next, other.m_tail.prev);
+    m_len += other.m_len;
+    other.m_len = 0;
+  }
+
+  /*!
+   *  Moves the element at `it` from `other` to right before `pos`, in O(1).
+   *  `other` may be this list.
+   */
+  void splice(const_iterator pos, intrusive_list &other, const_iterator it) {
+    list_hook *hook = it.m_ptr;
+    if (pos.m_ptr == hook || pos.m_ptr == hook->next) {
+      return;
+    }
+    detail::transfer(pos.m_ptr, hook, hook);
+    if (this != &other) {
+      ++m_len;
+      --other.m_len;
+    }
+  }
+
+  /*!
+   *  Moves the elements of [first, last) from `other` to right before `pos`.
+   *  Constant time when `other` is this list, linear in the range length otherwise.
+   */
+  void splice(const_iterator pos, intrusive_list &other, const_iterator first, const_iterator last) {
+    if (first == last) {
+      return;
+    }
+    if (this != &other) {
+      size_type count = 0;
+      for (auto it = first; it != last; ++it) {
+        ++count;
+      }
+      m_len += count;
+      other.m_len -= count;
+    }
+    detail::transfer(pos.m_ptr, first.m_ptr, last.m_ptr->prev);
+  }
+
+  //! Merges the sorted list `other` into this sorted list, comparing with `<`.
+  void merge(intrusive_list &other) { merge(other, std::less<>{}); }
+
+  /*!
+   *  Merges the sorted list `other` into this sorted list. Stable: among equal
+   *  elements, those already in this list come first. `other` is left empty.
+   *  \param comp Strict weak ordering both lists are sorted by.
+   */
+  template <typename Compare>
+  void merge(intrusive_list &other, Compare comp) {
+    if (this == &other) {
+      return;
+    }
+    list_hook *mine = m_head.next;
+    list_hook *theirs = other.m_head.next;
+    while (mine != &m_tail && theirs != &other.m_tail) {
+      if (comp(*owner_of(theirs), *owner_of(mine))) {
+        list_hook *next = theirs->next;
+        detail::transfer(mine, theirs, theirs);
+        theirs = next;
+      } else {
+        mine = mine->next;
+      }
+    }
+    if (theirs != &other.m_tail) {
+      detail::transfer(&m_tail, theirs, other.m_tail.prev);
+    }
+    m_len += other.m_len;
+    other.m_len = 0;
+  }
+
+private:
+  size_type m_len;  //!< Number of linked elements.
+  list_hook m_head; //!< Sentinel before the first element.
+  list_hook m_tail; //!< Sentinel after the last element.
+
+  //! Links the sentinels to each other, which is the empty list.
+  void init_sentinels() {
+    m_head.prev = nullptr;
+    m_head.next = &m_tail;
+    m_tail.prev = &m_head;
+    m_tail.next = nullptr;
+  }
+
+  //! Hangs the chain [first, last] between the sentinels; a null `first` leaves the list empty.
+  void hang_chain(list_hook *first, list_hook *last) {
+    init_sentinels();
+    if (first != nullptr) {
+      m_head.next = first;
+      first->prev = &m_head;
+      m_tail.prev = last;
+      last->next = &m_tail;
+    }
+  }
+};
+
+} // namespace sc
+#endif
@@ -6,8 +6,24 @@
 #include <algorithm> // copy
 #include <cassert>   // assert()
 #include <cstddef>   // std::ptrdiff_t
+#include <cstdint>   // std::uint64_t
+#include <cstring>   // std::memcpy, std::memcmp
+#include <exception> // std::exception_ptr
+#include <fstream>   // std::ifstream, std::ofstream
 #include <iterator>  // bidirectional_iterator_tag
+#include <memory>    // std::allocator_traits
+#include <new>       // std::launder
+#include <stdexcept> // std::out_of_range, std::runtime_error
+#include <string>
 #include <type_traits>
+#include <utility>   // std::move, std::forward, std::in_place
+#include <vector>
+
+#include "execution.h"
+#include "list_io.h"
+#include "list_links.h"
+#include "list_stats.h"
+#include "pool_allocator.h"
 
 namespace sc { // linear sequence. Better name: sequence container (same as
                // STL).
@@ -32,19 +48,30 @@ namespace sc { // linear sequence. Better name: sequence container (same as
   *  \class list
   *  \brief Doubly-linked list container class.
   *  \tparam T The type of data stored in the list.
+  *  \tparam Alloc The allocator used for the nodes (rebound to the node type).
+  *  By default nodes come from a slab pool, so the hot path never hits the heap.
+  *  \tparam Stats Statistics policy (see list_stats.h). The default `no_stats`
+  *  is an empty base, so lists that do not ask for statistics pay nothing.
   */
-template <typename T> 
-class list {
+template <typename T, typename Alloc = sc::pool_allocator<T>, typename Stats = sc::no_stats>
+class list : private Stats {
 
 private:
+  /*!
+   *  \struct node_base
+   *  \brief The links of a node. The sentinels are bare node_base objects, so they hold no data.
+   */
+  struct node_base {
+    node_base *next;   //!< Pointer to the next node.
+    node_base *prev;   //!< Pointer to the previous node.
+  };
+
   /*!
    *  \struct Node
    *  \brief Represents a node in the list.
    */
-  struct Node {
+  struct Node : node_base {
     T data;       //!< The data stored in the node.
-    Node *next;   //!< Pointer to the next node.
-    Node *prev;   //!< Pointer to the previous node.
 
 
     /*!
@@ -53,11 +80,45 @@ private:
      * \param n Pointer to the next node.
      * \param p Pointer to the previous node.
      */
-    Node(const T &d = T{}, Node *n = nullptr, Node *p = nullptr)
-     : data{d}, next{n}, prev{p} { /* empty */ }
+    Node(const T &d, node_base *n = nullptr, node_base *p = nullptr)
+     : node_base{n, p}, data{d} { /* empty */ }
+
+    /*!
+     * \brief Constructs the data of a new Node in place.
+     * \param args The arguments forwarded to the constructor of T.
+     */
+    template <typename... Args>
+    explicit Node(std::in_place_t, Args &&...args)
+     : node_base{nullptr, nullptr}, data(std::forward<Args>(args)...) { /* empty */ }
 
   };
 
+  //! Gives access to the data of a node that is known not to be a sentinel.
+  static Node *as_node(node_base *node) {
+    return static_cast<Node *>(node);
+  }
+
+  /*!
+   *  Counts the steps from `from` to `to`, negative if `to` comes first.
+   *  Walks both ways at once, so the cost is proportional to the distance.
+   *  \throw std::invalid_argument if `to` is not on the same list as `from`.
+   */
+  static std::ptrdiff_t steps_between(node_base *from, node_base *to) {
+    node_base *ahead = from;
+    node_base *behind = from;
+    std::ptrdiff_t steps = 0;
+    while (ahead != to && behind != to) {
+      if (ahead == nullptr && behind == nullptr) {
+        // Both walks ran off the ends of the list without meeting `to`.
+        throw std::invalid_argument("Os iteradores pertencem a listas diferentes");
+      }
+      ++steps;
+      if (ahead != nullptr) { ahead = ahead->next; }
+      if (behind != nullptr) { behind = behind->prev; }
+    }
+    return ahead == to ? steps : -steps;
+  }
+
 public:
   /*!
    *  \class const_iterator
@@ -67,18 +128,18 @@ public:
    ///=== Some aliases to help writing a clearer code.
   public:
     using value_type = T;  //!< The type of the value stored in the list.
-    using pointer = T *;   //!< Pointer to the value.
-    using reference = T &; //!< reference to the value.
+    using pointer = const T *;   //!< Pointer to the (read-only) value.
+    using reference = const T &; //!< Reference to the (read-only) value.
     using const_reference = const T &; //!< const reference to the value.
     using difference_type = std::ptrdiff_t;
     using iterator_category = std::bidirectional_iterator_tag;
 
   private:
-    Node *m_ptr;  //!< The raw pointer.
+    node_base *m_ptr;  //!< The raw pointer.
 
   public:
     //!  Standard constructor for const_iterator.
-    const_iterator(Node *ptr = nullptr) : m_ptr(ptr){ }
+    const_iterator(node_base *ptr = nullptr) : m_ptr(ptr){ }
 
     //!  Standard destructor for const_iterator.
     ~const_iterator() {m_ptr ==nullptr;}
@@ -103,18 +164,10 @@ public:
 
     /*!
      *  Dereference operator.
-     * \return Reference to the value pointed by the iterator.
-     */
-    reference operator*() {
-      return m_ptr->data;
-    }
-
-    /*!
-     *  Dereference operator (const version).
      * \return Const reference to the value pointed by the iterator.
      */
     const_reference operator*() const { 
-      return m_ptr->data;
+      return as_node(m_ptr)->data;
     }
 
     /*!
@@ -172,7 +225,7 @@ public:
      * \return True if the iterators point to different nodes, false otherwise.
     */
     bool operator!=(const const_iterator &rhs) const {
-      return *this != rhs.m_ptr;
+      return !(m_ptr == rhs.m_ptr);
     }
 
       ///=== Additional methods for the const_iterator class. 
@@ -186,6 +239,7 @@ public:
       for (int i = 0; i < step; i++) {
         m_ptr = m_ptr->next;
       }
+      Stats::on_advance(step > 0 ? step : 0);
       return *this;
     }
 
@@ -198,6 +252,7 @@ public:
       for (int i = 0; i < step; i++) {
         m_ptr = m_ptr->prev;
       }
+      Stats::on_advance(step > 0 ? step : 0);
       return *this;
     }
 
@@ -206,20 +261,21 @@ public:
      * \return Pointer to the data pointed to by the iterator.
      */
     pointer operator->() const { 
-      return m_ptr->data;
+      return &as_node(m_ptr)->data;
     }
 
     /*!
-     *  Calculates the difference between two const_iterators.
+     *  Counts the elements between two const_iterators of the same list, in O(distance).
      * \param rhs The other const_iterator to calculate the difference with.
-     * \return The difference between the two const_iterators.
+     * \return How many steps lead from `rhs` to this iterator; negative if this one comes first.
+     * \throw std::invalid_argument if the iterators belong to different lists.
      */
     difference_type operator-(const const_iterator &rhs) const { 
-      return m_ptr - rhs.m_ptr;
+      return steps_between(rhs.m_ptr, m_ptr);
     }
 
     //!  Allows the list<T> class to access the m_ptr field.
-    friend class list<T>;
+    friend class list;
 
     /*!
      *  Overloads the << operator to print the const_iterator.
@@ -228,7 +284,7 @@ public:
      * \return The modified output stream.
      */
     friend std::ostream &operator<<(std::ostream &os_, const const_iterator &s_) {
-      os_ << "[@" << s_.m_ptr << ", val = " << s_.m_ptr->data << "]";
+      os_ << "[@" << s_.m_ptr << ", val = " << *s_ << "]";
       return os_;
     }
   };
@@ -249,11 +305,11 @@ public:
     using iterator_category = std::bidirectional_iterator_tag;
 
   private:
-    Node *m_ptr; //!< The raw pointer.
+    node_base *m_ptr; //!< The raw pointer.
 
   public:
     //!  Standard constructor for iterator.
-    iterator(Node *ptr = nullptr) : m_ptr(ptr) { }
+    iterator(node_base *ptr = nullptr) : m_ptr(ptr) { }
     
     //!  Standard destructor for iterator.
     ~iterator() {m_ptr == nullptr;}
@@ -281,7 +337,7 @@ public:
      *  \return Reference to the value pointed by the iterator.
      */
     reference operator*() { 
-      return m_ptr->data;
+      return as_node(m_ptr)->data;
     }
 
     /*!
@@ -289,7 +345,7 @@ public:
      *  \return Const reference to the value pointed by the iterator.
      */
     const_reference operator*() const { 
-      return m_ptr->data;
+      return as_node(m_ptr)->data;
     }
 
     /*!
@@ -361,6 +417,7 @@ public:
       for (int i = 0; i < step; i++) {
         m_ptr = m_ptr->next;
       }
+      Stats::on_advance(step > 0 ? step : 0);
       return *this;
     }
 
@@ -373,6 +430,7 @@ public:
       for (int i = 0; i < step; i++) {
         m_ptr = m_ptr->prev;
       }
+      Stats::on_advance(step > 0 ? step : 0);
       return *this;
     }
 
@@ -381,20 +439,26 @@ public:
      *  \return Pointer to the data pointed to by the iterator.
      */
     pointer operator->() const { 
-      return m_ptr->data;
+      return &as_node(m_ptr)->data;
     }
 
     /*!
-     *  Calculates the difference between two const_iterators.
-     *  \param rhs The other const_iterator to calculate the difference with.
-     *  \return The difference between the two const_iterators.
+     *  Counts the elements between two iterators of the same list, in O(distance).
+     *  \param rhs The other iterator to calculate the difference with.
+     *  \return How many steps lead from `rhs` to this iterator; negative if this one comes first.
+     *  \throw std::invalid_argument if the iterators belong to different lists.
      */
     difference_type operator-(const iterator &rhs) const { 
-      return m_ptr - rhs.m_ptr;
+      return steps_between(rhs.m_ptr, m_ptr);
+    }
+
+    //! \brief Every iterator may be used where a const_iterator is expected.
+    operator const_iterator() const {
+      return const_iterator{m_ptr};
     }
 
     //! \brief Allows the list<T> class to access the m_ptr field.
-    friend class list<T>;
+    friend class list;
 
     /*!
      *  Overloads the << operator to print the iterator.
@@ -403,47 +467,202 @@ public:
      *  \return The modified output stream.
      */
     friend std::ostream &operator<<(std::ostream &os_, const iterator &s_) {
-      os_ << "[@" << s_.m_ptr << ", val = " << s_.m_ptr->data << "]";
+      os_ << "[@" << s_.m_ptr << ", val = " << *s_ << "]";
       return os_;
     }
   };
 
+  using value_type = T;          //!< The type of the elements.
+  using size_type = std::size_t; //!< The type of sizes and counts.
+  using allocator_type = Alloc; //!< The allocator type given by the client.
+
   //=== Private members of the class list.
 private:
+  using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
   size_t m_len; 
-  Node *m_head; 
-  Node *m_tail; 
+  node_base m_head; //!< Sentinel before the first element; lives inside the list object.
+  node_base m_tail; //!< Sentinel after the last element; lives inside the list object.
+  node_allocator m_alloc; //!< Where the nodes come from.
+  node_base *m_finger{nullptr}; //!< Last node reached by position, or null when unknown.
+  size_type m_finger_index{0};  //!< Position of `m_finger`.
+
+  /*!
+   *  Allocates a node and constructs it in place.
+   *  \param args Arguments forwarded to the Node constructor.
+   *  \return Pointer to the new node.
+   */
+  template <typename... Args>
+  Node *create_node(Args &&...args) {
+    Node *node = node_traits::allocate(m_alloc, 1);
+    try {
+      node_traits::construct(m_alloc, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(m_alloc, node, 1);
+      throw;
+    }
+    Stats::on_allocate(sizeof(Node));
+    return node;
+  }
+
+  //! Destroys a node and gives its memory back to the allocator.
+  void destroy_node(node_base *base) {
+    Node *node = as_node(base);
+    node_traits::destroy(m_alloc, node);
+    node_traits::deallocate(m_alloc, node, 1);
+    Stats::on_deallocate(sizeof(Node));
+  }
+
+  //! Links the sentinels to each other, which is the empty list.
+  void init_sentinels() {
+    m_head.prev = nullptr;
+    m_head.next = &m_tail;
+    m_tail.prev = &m_head;
+    m_tail.next = nullptr;
+    m_finger = nullptr;
+  }
+
+  /*!
+   *  Returns the node at position `index` (the tail sentinel if `index == m_len`).
+   *  Starts from the head, the tail or the finger, whichever is closest. The
+   *  finger is only read, so const callers may walk from several threads.
+   */
+  node_base *walk_to(size_type index) const;
+
+  //! Like `walk_to()`, then leaves the finger on the node it reached.
+  node_base *move_finger(size_type index) {
+    node_base *node = walk_to(index);
+    if (node != &m_tail) {
+      m_finger = node;
+      m_finger_index = index;
+    }
+    return node;
+  }
+
+  //! Keeps the finger right when `count` nodes are about to be linked before `pos`.
+  void finger_before_insert(const node_base *pos, size_type count = 1) {
+    if (m_finger == nullptr || pos == &m_tail || pos == m_finger->next) {
+      return;
+    }
+    if (pos == m_head.next || pos == m_finger) {
+      m_finger_index += count;
+    } else {
+      m_finger = nullptr;
+    }
+  }
+
+  //! Keeps the finger right when `node` is about to be unlinked.
+  void finger_before_erase(const node_base *node) {
+    if (m_finger == nullptr) {
+      return;
+    }
+    if (node == m_finger) {
+      m_finger = nullptr;
+    } else if (node == m_head.next || node == m_finger->prev) {
+      --m_finger_index;
+    } else if (node != m_tail.prev && node != m_finger->next) {
+      m_finger = nullptr; // Somewhere we cannot place without walking.
+    }
+  }
+
+
+  //! Ranges at least this long take all their nodes from one block, if the allocator can do it.
+  static constexpr size_type bulk_nodes = 64;
+
+  /*!
+   *  Creates nodes for the elements of [first, last) and links them right
+   *  before `pos`, bumping the size once. The chain is built aside, so the
+   *  list is left as it was if an element throws.
+   *
+   *  A long forward range tries to get its nodes from a single
+   *  `allocate_run()` of the allocator (see `pool_allocator`): they sit back
+   *  to back in the order they are linked, so walking the list walks memory
+   *  forwards.
+   */
+  template <typename InputIt>
+  void link_range(node_base *pos, InputIt first, InputIt last);
+
+  /*!
+   *  \class reclaimer
+   *  \brief Destroys nodes one at a time and gives their memory back in batches.
+   *
+   *  With an allocator that has a `release_batch` (see `pool_allocator`) the
+   *  memory is handed over a chain at a time, and whatever is left when the
+   *  reclaimer goes away, exceptions included. Otherwise each node is freed
+   *  on the spot.
+   */
+  class reclaimer {
+    using batch_type = typename detail::release_batch_of<node_allocator>::type;
+    static constexpr bool batched = !std::is_same<batch_type, detail::no_release_batch>::value;
+
+  public:
+    explicit reclaimer(list &owner) : m_owner(owner) { }
+    reclaimer(const reclaimer &) = delete;
+    reclaimer &operator=(const reclaimer &) = delete;
+
+    ~reclaimer() {
+      if constexpr (batched) {
+        m_owner.m_alloc.deallocate(m_batch);
+      }
+    }
+
+    void operator()(node_base *base) {
+      if constexpr (batched) {
+        Node *node = as_node(base);
+        node_traits::destroy(m_owner.m_alloc, node);
+        m_batch.add(node);
+        m_owner.on_deallocate(sizeof(Node));
+      } else {
+        m_owner.destroy_node(base);
+      }
+    }
+
+  private:
+    list &m_owner;
+    batch_type m_batch;
+  };
+
+  /*!
+   *  Unlinks every node whose element satisfies `pred`, in one pass. The node
+   *  holding `*spared` (if any) is destroyed only after the pass is over.
+   */
+  template <typename Pred>
+  size_type remove_nodes(Pred &pred, const T *spared);
+
+  void check_index(size_type index) const {
+    if (index >= m_len) {
+      throw std::out_of_range("Índice fora da lista");
+    }
+  }
 
   //=== Public members of the class list.
 public:
 
   //=== [I] Special members 
   //! \brief Default constructor for list. Constructs an empty list.
-  list() : m_len(0), m_head(nullptr), m_tail(nullptr) {
-    m_head = new Node();
-    m_tail = new Node();
-    m_head->next = m_tail;
-    m_tail->prev = m_head;
+  list() : m_len(0) {
+    init_sentinels();
+  }
+
+  //! \brief Constructs an empty list that allocates its nodes through `alloc`.
+  explicit list(const allocator_type &alloc) : m_len(0), m_alloc(alloc) {
+    init_sentinels();
   }
 
   /*!
    *  Constructs a list with the specified number of elements.
    *  \param count The number of elements to initialize the list with.
    */
-  list(size_t count) {
-    m_len = 0;
-    m_head = new Node();
-    m_tail = new Node();
-    m_head->next = m_tail;
-    m_tail->prev = m_head;
-    
-    for(auto i{0}; i < count; ++i){
-      Node *new_n = new Node(T());
-      new_n->prev = m_tail->prev;
-      new_n->next = m_tail;
-      m_tail->prev->next = new_n;
-      m_tail->prev = new_n;
+  list(size_t count) : list() {
+    for(size_t i{0}; i < count; ++i){
+      Node *new_n = create_node(std::in_place);
+      new_n->prev = m_tail.prev;
+      new_n->next = &m_tail;
+      m_tail.prev->next = new_n;
+      m_tail.prev = new_n;
       ++m_len; 
+      Stats::on_grow(m_len);
     }
     
   }
@@ -464,6 +683,19 @@ public:
    */
   list(const list &clone_);
 
+  /*!
+   *  Move constructor. Takes over the nodes of another list without copying any element.
+   *  \param other The list to move from; it is left empty.
+   */
+  list(list &&other) noexcept : m_len(0), m_alloc(std::move(other.m_alloc)) {
+    init_sentinels();
+    hang_chain(other.empty() ? nullptr : other.m_head.next, other.m_tail.prev);
+    m_len = other.m_len;
+    Stats::on_grow(m_len);
+    other.init_sentinels();
+    other.m_len = 0;
+  }
+
   /*!
    *  Constructs a list with elements from an initializer list.
    *  \param ilist_ The initializer list to initialize the list with.
@@ -477,10 +709,18 @@ public:
    *  Swaps the contents of two lists.
    *  \param other The other list to swap with.
    */
-  void swap(list &other) {
+  void swap(list &other) noexcept {
+    // The sentinels stay where they are; only the chains of nodes change hands.
+    node_base *first = empty() ? nullptr : m_head.next;
+    node_base *other_first = other.empty() ? nullptr : other.m_head.next;
+    node_base *last = m_tail.prev;
+    node_base *other_last = other.m_tail.prev;
+    hang_chain(other_first, other_last);
+    other.hang_chain(first, last);
     std::swap(m_len, other.m_len);
-    std::swap(m_head, other.m_head);
-    std::swap(m_tail, other.m_tail);
+    std::swap(m_alloc, other.m_alloc);
+    Stats::on_grow(m_len);
+    other.on_grow(other.m_len);
   }
 
   /*!
@@ -496,6 +736,19 @@ public:
     return *this;
   }
 
+  /*!
+   *  Move assignment operator. Releases the current elements and takes over the nodes of `rhs`.
+   *  \param rhs The list to move from; it is left empty.
+   *  \return Reference to the updated list.
+   */
+  list &operator=(list &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
   /*!
    *  Assignment operator. Replaces the contents of the list with elements from an initializer list.
    *  \param ilist_ The initializer list to copy from.
@@ -515,7 +768,7 @@ public:
    *  \return An iterator pointing to the first element.
    */
   iterator begin() { 
-    return iterator{m_head->next};
+    return iterator{m_head.next};
   }
 
   /*!
@@ -523,7 +776,7 @@ public:
    * \return A const iterator pointing to the first element.
    */
   const_iterator cbegin() const { 
-    return const_iterator{m_head->next};
+    return const_iterator{m_head.next};
   }
 
   /*!
@@ -531,7 +784,7 @@ public:
    *  \return An iterator pointing to the past-the-end element.
    */
   iterator end() {
-    return iterator{m_tail};
+    return iterator{&m_tail};
   }
 
   /**
@@ -539,7 +792,7 @@ public:
    * \return A const iterator pointing to the past-the-end element.
    */
   const_iterator cend() const { 
-    return const_iterator{m_tail};
+    return const_iterator{const_cast<node_base *>(&m_tail)};
   }
 
 
@@ -561,22 +814,29 @@ public:
     return m_len;
   }
 
+  //! \brief Returns a copy of the allocator associated with the list.
+  allocator_type get_allocator() const {
+    return allocator_type(m_alloc);
+  }
+
+  //! \brief Returns the counters gathered by the statistics policy; all zero with `no_stats`.
+  stats_snapshot stats() const {
+    return Stats::snapshot(m_len, sizeof(Node));
+  }
+
 
   //=== [IV] Modifiers
   //!  Removes all elements from the list.
   void clear() {
-    while(!empty()){
-      pop_back();
+    {
+      reclaimer reclaim{*this};
+      for (node_base *runner = m_head.next; runner != &m_tail;) {
+        node_base *next = runner->next;
+        reclaim(runner);
+        runner = next;
+      }
     }
-
-    delete m_head;
-    delete m_tail;
-
-    m_head = new Node();
-    m_tail = new Node();
-    m_head->next = m_tail;
-    m_tail->prev = m_head;
-
+    init_sentinels();
     m_len = 0;
   }
 
@@ -587,7 +847,7 @@ public:
    */
   T front() {
     if(empty()) { throw std::out_of_range("A lista está vazia"); }
-    return T{m_head->next->data};
+    return T{as_node(m_head.next)->data};
   }
 
   /**
@@ -597,7 +857,7 @@ public:
    */
   T front() const {
     if(empty()) { throw std::out_of_range("A lista está vazia"); }
-    return T{m_head->next->data};
+    return T{as_node(m_head.next)->data};
   }
 
 
@@ -608,7 +868,7 @@ public:
    */
   T back() { 
     if(empty()) { throw std::out_of_range("A lista está vazia"); }
-    return T{m_tail->prev->data};
+    return T{as_node(m_tail.prev)->data};
   }
 
   /*!
@@ -618,20 +878,97 @@ public:
    */
   T back() const { 
     if(empty()) { throw std::out_of_range("A lista está vazia"); }
-    return T{m_tail->prev->data};
+    return T{as_node(m_tail.prev)->data};
+  }
+
+  /*!
+   *  Returns the element at position `index`.
+   *
+   *  The list remembers the last position it reached this way, and walks
+   *  from there, from the head or from the tail, whichever is closest. A loop
+   *  over nearby indices therefore costs O(1) per step instead of O(n). The
+   *  remembered position survives `push_back()`, `push_front()`, `pop_front()`
+   *  and `pop_back()`; most other changes make the list forget it.
+   *
+   *  \throw std::out_of_range if `index >= size()`.
+   */
+  T &at(size_type index) {
+    check_index(index);
+    return as_node(move_finger(index))->data;
+  }
+
+  /*!
+   *  Const version: walks from the remembered position too, but leaves it
+   *  where it is, so concurrent const calls do not race. A loop over a const
+   *  list only benefits from it if a non-const call placed it nearby.
+   *  \throw std::out_of_range if `index >= size()`.
+   */
+  const T &at(size_type index) const {
+    check_index(index);
+    return as_node(walk_to(index))->data;
+  }
+
+  /*!
+   *  Returns an iterator to the element at position `index` (end() if
+   *  `index == size()`), walking like `at()` does. The const version leaves
+   *  the remembered position alone, like `at() const`.
+   *  \throw std::out_of_range if `index > size()`.
+   */
+  iterator nth(size_type index) {
+    if (index > m_len) { throw std::out_of_range("Posição fora da lista"); }
+    return iterator{move_finger(index)};
+  }
+
+  const_iterator nth(size_type index) const {
+    if (index > m_len) { throw std::out_of_range("Posição fora da lista"); }
+    return const_iterator{walk_to(index)};
   }
 
   /*!
    *  Inserts a new element at the beginning of the list.
    *  \param value_ The value of the element to insert.
    */
-  void push_front(const T &value_);
+  void push_front(const T &value_) {
+    emplace_front(value_);
+  }
+
+  //! \brief Inserts a new element at the beginning of the list, moving from `value_`.
+  void push_front(T &&value_) {
+    emplace_front(std::move(value_));
+  }
 
   /*!
    * \brief Inserts a new element at the end of the list.
    * \param value_ The value of the element to insert.
    */
-  void push_back(const T &value_);
+  void push_back(const T &value_) {
+    emplace_back(value_);
+  }
+
+  //! \brief Inserts a new element at the end of the list, moving from `value_`.
+  void push_back(T &&value_) {
+    emplace_back(std::move(value_));
+  }
+
+  /*!
+   *  Constructs a new element in place at the beginning of the list.
+   *  \param args The arguments forwarded to the constructor of T.
+   *  \return Reference to the new element.
+   */
+  template <typename... Args>
+  T &emplace_front(Args &&...args) {
+    return *emplace(cbegin(), std::forward<Args>(args)...);
+  }
+
+  /*!
+   *  Constructs a new element in place at the end of the list.
+   *  \param args The arguments forwarded to the constructor of T.
+   *  \return Reference to the new element.
+   */
+  template <typename... Args>
+  T &emplace_back(Args &&...args) {
+    return *emplace(cend(), std::forward<Args>(args)...);
+  }
 
   //! \brief Removes the first element of the list.
   void pop_front();
@@ -651,10 +988,7 @@ public:
    */
   template <class InItr> void assign(InItr first_, InItr last_) {
     clear();
-    while(first_ != last_){
-      push_back(*first_);
-      first_++;
-    }
+    link_range(&m_tail, first_, last_);
   }
 
   /*!
@@ -676,7 +1010,24 @@ public:
    *  \param value_ The value we want to insert in the list. 
    *  \return An iterator to the new element in the list.
    */
-  iterator insert(iterator pos_, const T &value_);
+  iterator insert(const_iterator pos_, const T &value_) {
+    return emplace(pos_, value_);
+  }
+
+  //!  Inserts a new value before `pos_`, moving from `value_`, and returns an iterator to it.
+  iterator insert(const_iterator pos_, T &&value_) {
+    return emplace(pos_, std::move(value_));
+  }
+
+  /*!
+   *  Constructs a new element in place right before `pos_`.
+   *
+   *  \param pos_ An iterator to the position before which the element is created.
+   *  \param args The arguments forwarded to the constructor of T.
+   *  \return An iterator to the new element.
+   */
+  template <typename... Args>
+  iterator emplace(const_iterator pos_, Args &&...args);
 
   /*!
    *  Inserts elements from the range [first, last) into the list before 'it'.
@@ -690,7 +1041,7 @@ public:
    *  \return An iterator pointing to the last inserted element.
    */
   template <typename InItr>
-  iterator insert(iterator pos_, InItr first_, InItr last_);
+  iterator insert(const_iterator pos_, InItr first_, InItr last_);
 
   
   /*!
@@ -700,7 +1051,7 @@ public:
     *  \param ilist_ The initializer list to insert elements from.
     *  \return An iterator pointing to the last inserted element.
     */
-  iterator insert(iterator cpos_, std::initializer_list<T> ilist_);
+  iterator insert(const_iterator cpos_, std::initializer_list<T> ilist_);
 
   /*!
    *  Erases the node pointed by 'it_' and returns an iterator
@@ -709,10 +1060,10 @@ public:
    *  \param it_ The node we wish to delete.
    *  \return An iterator to the node following the deleted node.
    */
-  iterator erase(iterator it_);
+  iterator erase(const_iterator it_);
 
   //!  Erase items from [start; end) and return a iterator just past the deleted node.
-  iterator erase(iterator start, iterator end);
+  iterator erase(const_iterator start, const_iterator end);
   
   /*! 
     *   Finds the first occurrence of the specified value in the list.
@@ -730,13 +1081,34 @@ public:
   
   
   /*!
-   *  Partitions the list by rearranging its elements according to a pivot value.
+   *  Reorders [first, last) so that the elements for which `pred` returns
+   *  true come before those for which it returns false.
    *
-   *  \param start_ An iterator pointing to the beginning of the range to partition.
-   *  \param end_ An iterator pointing to the end of the range to partition.
-   *  \return An iterator pointing to the partition point.
+   *  Nodes are relinked, never copied, swapped or allocated, and iterators
+   *  keep pointing to the same elements. Moving a node costs the same
+   *  wherever it goes, so this simply keeps the order of both groups, as
+   *  `stable_partition()` does.
+   *
+   *  \param first An iterator pointing to the beginning of the range to partition.
+   *  \param last An iterator pointing to the end of the range to partition.
+   *  \param pred Called once per element, in order.
+   *  \return An iterator to the first element of the second group, or `last` if it is empty.
+   */
+  template <typename Pred>
+  iterator partition(const_iterator first, const_iterator last, Pred pred) {
+    return stable_partition(first, last, pred);
+  }
+
+  /*!
+   *  Like `partition()`, and each group keeps the relative order of its elements.
+   *  Linear time: the nodes of the second group are unlinked as they are met
+   *  and hung back in one piece right before `last`. If `pred` throws, they are
+   *  hung back all the same, so the list stays whole.
+   *
+   *  \return An iterator to the first element of the second group, or `last` if it is empty.
    */
-  iterator partition(iterator start_, iterator end_);
+  template <typename Pred>
+  iterator stable_partition(const_iterator first, const_iterator last, Pred pred);
   
 
   //=== [V] UTILITY METHODS
@@ -751,24 +1123,168 @@ public:
    *  Splices elements from another list into this list at the specified position.
    *  \param  pos An iterator pointing to the position in this list to insert the spliced elements.
    *  \param  other The list to splice into this list.
+   *  \note Constant time: only the boundary nodes are relinked.
    */
   void splice(const_iterator pos, list &other);
 
-  //!  Reverse the order of the elements in the list.
+  /*!
+   *  Moves the element pointed by `it` from `other` into this list, before `pos`.
+   *  Constant time; `other` may be this same list.
+   *
+   *  \param  pos An iterator pointing to the position in this list to insert the element.
+   *  \param  other The list the element comes from.
+   *  \param  it An iterator to the element to be moved.
+   */
+  void splice(const_iterator pos, list &other, const_iterator it);
+
+  /*!
+   *  Moves the elements in [first, last) from `other` into this list, before `pos`.
+   *  Only the boundary nodes are relinked. When `other` is a different list the
+   *  range is walked once to keep both sizes right, so that case is linear in the
+   *  length of the range; within the same list it is constant time.
+   *
+   *  \param  pos An iterator pointing to the position in this list to insert the elements.
+   *  \param  other The list the elements come from.
+   *  \param  first The beginning of the range to move.
+   *  \param  last The end of the range to move (not included).
+   */
+  void splice(const_iterator pos, list &other, const_iterator first, const_iterator last);
+
+  //!  Reverse the order of the elements in the list by swapping the links of each node. No allocation, no copies.
   void reverse();
 
   //!  Removes all duplicate elements from the list.
   void unique();
 
-  //!  Sorts the list in non-descending order.
+  /*!
+   *  Removes every element equal to `value_`. `value_` may be an element of this list.
+   *  \return The number of elements removed.
+   */
+  size_type remove(const T &value_);
+
+  /*!
+   *  Removes every element for which `pred` returns true, in a single pass.
+   *  Matching nodes are unlinked as they are found and released together at
+   *  the end, so the pool is visited once rather than once per node.
+   *
+   *  \param pred Called once per element, in order.
+   *  \return The number of elements removed.
+   */
+  template <typename Pred>
+  size_type remove_if(Pred pred);
+
+  //!  Sorts the list in non-descending order (stable, only relinks nodes).
   void sort();
 
-  /*!  Sorts the elements in the list in non-descending order with the range wich we chose
+  /*!
+   *  Sorts the list according to `comp` with a bottom-up merge sort.
+   *  The sort is stable, never allocates and never copies or moves elements:
+   *  nodes are only relinked, so iterators remain valid.
+   *
+   *  \tparam Compare A binary predicate that returns true if its first argument goes before the second.
+   *  \param comp The comparison function object.
+   */
+  template <typename Compare>
+  void sort(Compare comp);
+
+  /*!
+   *  Sorts the list in non-descending order using several threads.
+   *  \param policy Tells how many threads to use and below which size to sort sequentially.
+   */
+  void sort(const execution::parallel_policy &policy);
+
+  /*!
+   *  Sorts the list according to `comp` using several threads. The list is cut
+   *  into one segment per thread, the segments are sorted concurrently by
+   *  relinking their nodes, and the sorted runs are merged pairwise in a tree.
+   *  The result is the same as `sort(comp)`: stable, no allocation of nodes and
+   *  no copies of elements. `comp` must be safe to call from several threads.
+   *
+   *  \param policy Tells how many threads to use and below which size to sort sequentially.
+   *  \param comp The comparison function object.
+   */
+  template <typename Compare>
+  void sort(const execution::parallel_policy &policy, Compare comp);
+
+  //=== [VI] SERIALIZATION
+
+  /*!
+   *  Writes the list in a compact binary format: a header (element count,
+   *  element size, checksum) followed by the raw bytes of the elements,
+   *  copied through a large buffer. Only for trivially copyable `T`.
+   *
+   *  \param os_ A stream opened in binary mode.
+   *  \throw std::runtime_error if the stream fails.
+   */
+  void save(std::ostream &os_) const;
+
+  /*!
+   *  Writes the list to the file `path_`, replacing it.
+   *  \throw std::runtime_error if the file cannot be opened or written.
+   */
+  void save(const std::string &path_) const;
+
+  /*!
+   *  Replaces the contents of the list with a list written by `save()`.
+   *  The node pool is sized for the whole list before reading, and the
+   *  elements are read through a large buffer. If anything goes wrong the
+   *  list is left unchanged.
    *
-   *  \param start_ An iterator pointing to the beginning of the range to sort.
-   *  \param end_ An iterator pointing to the end of the range to sort.
+   *  \param is_ A stream opened in binary mode.
+   *  \throw std::runtime_error if the data is not a saved list of this `T`,
+   *  is truncated, or does not match its checksum.
+   */
+  void load(std::istream &is_);
+
+  /*!
+   *  Replaces the contents of the list with the list saved in the file `path_`.
+   *  \throw std::runtime_error if the file cannot be opened or is not a valid saved list.
    */
-  void sort_aux(iterator start_, iterator end_);
+  void load(const std::string &path_);
+
+private:
+  //! Bytes moved per read or write call by save() and load().
+  static constexpr size_t io_buffer_bytes = 1 << 20;
+
+  /*!
+   *  Merges two sorted chains linked through `next` (null terminated) into `out`.
+   *  On ties nodes from `a` come first, which keeps the merge stable. If `comp`
+   *  throws, `out` still holds every node of both chains.
+   */
+  template <typename Compare>
+  static void merge_chains(node_base *&out, node_base *a, node_base *b, Compare &comp);
+
+  /*!
+   *  Sorts a null-terminated chain linked through `next` in place. Runs of 2^i
+   *  nodes are kept in bin `i` and merged like a binary counter, so no recursion
+   *  is needed and the extra space is a fixed array of 64 pointers. If `comp`
+   *  throws, `first` still holds every node, in some unspecified order.
+   */
+  template <typename Compare>
+  static void sort_chain(node_base *&first, Compare &comp);
+
+  //!  Appends chain `b` to chain `a` (both null terminated) and returns the result.
+  static node_base *concat_chains(node_base *a, node_base *b);
+
+  //!  Hangs a null-terminated chain between the sentinels, rebuilding the `prev` links.
+  void adopt_chain(node_base *first);
+
+  /*!
+   *  Hangs the doubly-linked chain [first, last] between the sentinels, replacing
+   *  whatever they pointed to. A null `first` leaves the list empty.
+   */
+  void hang_chain(node_base *first, node_base *last) {
+    init_sentinels();
+    if (first != nullptr) {
+      m_head.next = first;
+      first->prev = &m_head;
+      m_tail.prev = last;
+      last->next = &m_tail;
+    }
+  }
+
+  //!  Unlinks the nodes [first, last] (both included) and links them back right before `pos`.
+  static void transfer(node_base *pos, node_base *first, node_base *last);
 };
 
 
@@ -779,12 +1295,14 @@ public:
  *  Equality comparison operator. Checks if two lists are equal.
  *
  *  \tparam T The type of elements in the lists.
+ *  \tparam Alloc The allocator of the lists.
+ *  \tparam Stats The statistics policy of the lists.
  *  \param l1_ The first list.
  *  \param l2_ The second
  *  \return True if the lists are equal, false otherwise.
  */
-template <typename T>
-inline bool operator==(const sc::list<T> &l1_, const sc::list<T> &l2_) {
+template <typename T, typename Alloc, typename Stats>
+inline bool operator==(const sc::list<T, Alloc, Stats> &l1_, const sc::list<T, Alloc, Stats> &l2_) {
   if (l1_.size() != l2_.size()) { return false; }
 
   auto it1{l1_.cbegin()};
@@ -803,212 +1321,252 @@ inline bool operator==(const sc::list<T> &l1_, const sc::list<T> &l2_) {
  *  Inequality comparison operator. Checks if two lists are not equal.
  *
  *  \tparam T The type of elements in the lists.
+ *  \tparam Alloc The allocator of the lists.
+ *  \tparam Stats The statistics policy of the lists.
  *  \param l1_ The first list.
  *  \param l2_ The second list to compare.
  * 
  *  \return true if the lists are not equal, false otherwise.
  */
-template <typename T>
-inline bool operator!=(const sc::list<T> &l1_, const sc::list<T> &l2_) {
+template <typename T, typename Alloc, typename Stats>
+inline bool operator!=(const sc::list<T, Alloc, Stats> &l1_, const sc::list<T, Alloc, Stats> &l2_) {
   return !(l1_ == l2_);
 }
+
+/*!
+ *  Erases every element of `list_` for which `pred` returns true, like `list::remove_if()`.
+ *  \return The number of elements erased.
+ */
+template <typename T, typename Alloc, typename Stats, typename Pred>
+inline typename sc::list<T, Alloc, Stats>::size_type erase_if(sc::list<T, Alloc, Stats> &list_, Pred pred) {
+  return list_.remove_if(pred);
+}
 } // namespace sc
-#endif 
 
 
 
-  template <typename T>
+  template <typename T, typename Alloc, typename Stats>
   template <typename InputIt> 
-  sc::list<T>::list(InputIt first, InputIt last){
-    m_len = 0;
-    m_head = new Node(T(), m_tail, nullptr);
-    m_tail = new Node(T(), nullptr, m_head);
-    while(first != last){
-      push_back(*first);
-      first++;
-    }
-    
+  sc::list<T, Alloc, Stats>::list(InputIt first, InputIt last) : list() {
+    link_range(&m_tail, first, last);
   }
 
 
-  template <typename T>
-  sc::list<T>::list(const list &clone_){
-    m_head=new Node(T(), m_tail, nullptr);
-    m_tail=new Node(T(), nullptr, m_head);
-    Node *runo=clone_.m_head->next;
-    Node *p=m_head;
-    while (runo != clone_.m_tail) {
-        Node *nn=new Node(runo->data, m_tail, p);
-        p->next=nn;
-        m_tail->prev=nn;
-        p=nn;
-        runo=runo->next;
-    }
-    m_len=clone_.m_len;
-  }
-
-  template <typename T>
-  sc::list<T>::list(std::initializer_list<T> ilist_) : list() {
-    Node *p=m_head;
-    auto runner=ilist_.begin();
-    m_len=0;
-    while(runner != ilist_.end()) {
-        Node *nn=new Node(*runner, m_tail, p);
-        p->next=nn;
-        m_tail->prev=nn;
-        p=nn;
-        runner++;
-        m_len++;
-    }
-}
-
-  template <typename T>
-  sc::list<T>::~list() {
-    clear();
-    delete m_head;
-    delete m_tail;
-  } 
-
-
-
-  template <typename T>
-  void sc::list<T>::push_front(const T &value_){
-    Node *new_node = new Node(value_);
-    new_node->next = m_head->next;
-    new_node->prev = m_head;
-    m_head->next->prev = new_node;
-    m_head->next = new_node;
-    m_len++;
+  template <typename T, typename Alloc, typename Stats>
+  sc::list<T, Alloc, Stats>::list(const list &clone_)
+    : m_len(0), m_alloc{node_traits::select_on_container_copy_construction(clone_.m_alloc)} {
+    init_sentinels();
+    link_range(&m_tail, clone_.cbegin(), clone_.cend());
   }
 
-  template <typename T>
-  void sc::list<T>::push_back(const T &value_){
-    Node *new_node = new Node(value_, nullptr, nullptr);
-    new_node->next = m_tail;
-    m_tail->prev->next = new_node;
-    new_node->prev = m_tail->prev;
-    m_tail->prev = new_node;
-    m_len++; 
+  template <typename T, typename Alloc, typename Stats>
+  sc::list<T, Alloc, Stats>::list(std::initializer_list<T> ilist_) : list() {
+    link_range(&m_tail, ilist_.begin(), ilist_.end());
   }
 
-  template <typename T>
-  void sc::list<T>::pop_front(){
-    if(m_head->next != m_tail){
-      Node *first = m_head->next;
-      Node *new_first = first->next;
-  
+  template <typename T, typename Alloc, typename Stats>
+  sc::list<T, Alloc, Stats>::~list() {
+    clear();
+  } 
 
-    m_head->next = new_first;
-    new_first->prev = m_head;
 
-    delete first;
-    --m_len;
-    }
-  }
 
-  template <typename T>
-  void sc::list<T>::pop_back(){
-    if(m_len == 0){
-      throw std::out_of_range("Lista vazia");
+  template <typename T, typename Alloc, typename Stats>
+  template <typename InputIt>
+  void sc::list<T, Alloc, Stats>::link_range(node_base *pos, InputIt first, InputIt last){
+    node_base chain{nullptr, nullptr};
+    node_base *prev = &chain;
+    size_t count = 0;
+    bool packed = false;
+
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value &&
+                  detail::has_allocate_run<node_allocator>::value) {
+      size_t n = static_cast<size_t>(std::distance(first, last));
+      // Null when the pool would rather reuse free nodes one at a time.
+      Node *run = n >= bulk_nodes ? m_alloc.allocate_run(n) : nullptr;
+      if (run != nullptr) {
+        try {
+          for (; count < n; ++count, ++first) {
+            node_traits::construct(m_alloc, run + count, std::in_place, *first);
+            prev->next = run + count;
+            run[count].prev = prev;
+            prev = run + count;
+          }
+        } catch (...) {
+          for (size_t i{0}; i < n; ++i) {
+            if (i < count) { node_traits::destroy(m_alloc, run + i); }
+            node_traits::deallocate(m_alloc, run + i, 1);
+          }
+          throw;
+        }
+        for (size_t i{0}; i < n; ++i) {
+          Stats::on_allocate(sizeof(Node));
+        }
+        packed = true;
+      }
     }
 
-    if(m_tail->prev != m_head){
-      Node *last = m_tail->prev;
-      Node *new_last = last->prev;
-
-      m_tail->prev = new_last;
-      new_last->next = m_tail;
+    if (!packed) {
+      try {
+        for (; first != last; ++first) {
+          Node *node = create_node(std::in_place, *first);
+          prev->next = node;
+          node->prev = prev;
+          prev = node;
+          ++count;
+        }
+      } catch (...) {
+        for (node_base *runner = chain.next; count != 0; --count) {
+          node_base *next = runner->next;
+          destroy_node(runner);
+          runner = next;
+        }
+        throw;
+      }
+    }
 
-      delete last;
-      --m_len;
+    if (count == 0) {
+      return;
     }
+    finger_before_insert(pos, count);
+    node_base *before = pos->prev;
+    before->next = chain.next;
+    chain.next->prev = before;
+    prev->next = pos;
+    pos->prev = prev;
+    m_len += count;
+    Stats::on_grow(m_len);
   }
 
-  template <typename T>
-  typename sc::list<T>::iterator sc::list<T>::insert(iterator pos_, const T &value_){
-    if (pos_.m_ptr == m_head) {
-      push_front(value_);
-      return iterator{m_head->next};
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::node_base *sc::list<T, Alloc, Stats>::walk_to(size_type index) const {
+    node_base *node = const_cast<node_base *>(&m_head);
+    size_type at = 0;
+    size_type steps = index + 1;
+    if (m_len - index < steps) {
+      node = const_cast<node_base *>(&m_tail);
+      at = m_len + 1;
+      steps = m_len - index;
     }
-
-    if (pos_.m_ptr == m_tail) {
-      push_back(value_);
-      return iterator{m_tail->prev};
+    if (m_finger != nullptr) {
+      size_type from_finger = m_finger_index > index ? m_finger_index - index : index - m_finger_index;
+      if (from_finger < steps) {
+        node = m_finger;
+        at = m_finger_index + 1;
+        steps = from_finger;
+      }
     }
 
-    Node* newNode = new Node(value_, nullptr, nullptr);
+    // `at` counts the head sentinel as 0, so element `index` is at `index + 1`.
+    for (; at < index + 1; ++at) { node = node->next; }
+    for (; at > index + 1; --at) { node = node->prev; }
+    Stats::on_traverse(steps);
+    return node;
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  template <typename... Args>
+  typename sc::list<T, Alloc, Stats>::iterator sc::list<T, Alloc, Stats>::emplace(const_iterator pos_, Args &&...args){
+    Node *newNode = create_node(std::in_place, std::forward<Args>(args)...);
 
-    Node* prevNode = pos_.m_ptr->prev;
-    Node* nextNode = pos_.m_ptr;
+    node_base *nextNode = pos_.m_ptr;
+    node_base *prevNode = nextNode->prev;
+    finger_before_insert(nextNode);
 
     newNode->prev = prevNode;
-    std::cout << "prevNode: " << prevNode->data << std::endl;
     newNode->next = nextNode;
-    std::cout << "nextNode: " << nextNode->data << std::endl;
     prevNode->next = newNode;
-    std::cout << "prevNode->next: " << prevNode->next->data << std::endl;
     nextNode->prev = newNode;
-    std::cout << "nextNode->prev: " << nextNode->prev->data << std::endl;
 
     ++m_len;
+    Stats::on_grow(m_len);
 
-    return iterator{pos_};
+    return iterator{newNode};
+  }
 
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::pop_front(){
+    if(m_head.next != &m_tail){
+      node_base *first = m_head.next;
+      node_base *new_first = first->next;
+      finger_before_erase(first);
+
+    m_head.next = new_first;
+    new_first->prev = &m_head;
+
+    destroy_node(first);
+    --m_len;
+    }
   }
 
-  template <typename T>
-  template <typename InputIt>
-  typename sc::list<T>::iterator sc::list<T>::insert(iterator pos_, InputIt first_, InputIt last_){
-    Node *prevNode = pos_.m_ptr->prev;
-    Node *nextNode = pos_.m_ptr;
-
-    for (InputIt it = first_; it != last_; it++) {
-      Node *newNode = new Node(*it);
-      newNode->prev = prevNode;
-      newNode->next = nextNode;
-      prevNode->next = newNode;
-      nextNode->prev = newNode;
-      prevNode = newNode;
-      ++m_len;
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::pop_back(){
+    if(m_len == 0){
+      throw std::out_of_range("Lista vazia");
     }
 
-    return iterator{pos_};
+    if(m_tail.prev != &m_head){
+      node_base *last = m_tail.prev;
+      node_base *new_last = last->prev;
+      finger_before_erase(last);
+
+      m_tail.prev = new_last;
+      new_last->next = &m_tail;
+
+      destroy_node(last);
+      --m_len;
+    }
   }
 
-  template <typename T>
-  typename sc::list<T>::iterator sc::list<T>::insert(iterator cpos_, std::initializer_list<T> ilist_){
+  template <typename T, typename Alloc, typename Stats>
+  template <typename InputIt>
+  typename sc::list<T, Alloc, Stats>::iterator sc::list<T, Alloc, Stats>::insert(const_iterator pos_, InputIt first_, InputIt last_){
+    link_range(pos_.m_ptr, first_, last_);
+    return iterator{pos_.m_ptr};
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::iterator sc::list<T, Alloc, Stats>::insert(const_iterator cpos_, std::initializer_list<T> ilist_){
     return insert(cpos_, ilist_.begin(), ilist_.end());
   }
 
-  template <typename T>
-  typename sc::list<T>::iterator sc::list<T>::erase(iterator it_){
-    if (it_.m_ptr == m_head || it_.m_ptr == m_tail) {
-      return it_;
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::iterator sc::list<T, Alloc, Stats>::erase(const_iterator it_){
+    if (it_.m_ptr == &m_head || it_.m_ptr == &m_tail) {
+      return iterator{it_.m_ptr};
     }
 
-    Node *prevNode = it_.m_ptr->prev;
-    Node *nextNode = it_.m_ptr->next;
+    node_base *prevNode = it_.m_ptr->prev;
+    node_base *nextNode = it_.m_ptr->next;
+    finger_before_erase(it_.m_ptr);
 
     prevNode->next = nextNode;
     nextNode->prev = prevNode;
 
-    delete it_.m_ptr;
+    destroy_node(it_.m_ptr);
     --m_len;
 
     return iterator{nextNode};
   }
 
-  template <typename T>
-  typename sc::list<T>::iterator sc::list<T>::erase(iterator start, iterator end){
-    Node *prevNode = start.m_ptr->prev;
-    Node *nextNode = end.m_ptr;
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::iterator sc::list<T, Alloc, Stats>::erase(const_iterator start, const_iterator end){
+    node_base *prevNode = start.m_ptr->prev;
+    node_base *nextNode = end.m_ptr;
+    size_t visited = 0;
+    if (start != end) {
+      m_finger = nullptr;
+    }
 
     while (start != end) {
-      Node *aux = start.m_ptr;
+      node_base *aux = start.m_ptr;
       start++;
-      delete aux;
+      destroy_node(aux);
       --m_len;
+      ++visited;
     }
+    Stats::on_traverse(visited);
 
     prevNode->next = nextNode;
     nextNode->prev = prevNode;
@@ -1016,40 +1574,39 @@ inline bool operator!=(const sc::list<T> &l1_, const sc::list<T> &l2_) {
     return iterator{nextNode};
   }
 
-  template <typename T>
-  typename sc::list<T>::const_iterator sc::list<T>::find(const T &value_) const{
-    for (auto it = begin(); it != end(); it++) {
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::const_iterator sc::list<T, Alloc, Stats>::find(const T &value_) const{
+    size_t visited = 0;
+    for (auto it = cbegin(); it != cend(); it++) {
+      ++visited;
       if (*it == value_) {
+        Stats::on_traverse(visited);
         return it;
       }
     }
-    return end();
+    Stats::on_traverse(visited);
+    return cend();
   }
 
-  template <typename T>
-  typename sc::list<T>::iterator sc::list<T>::find(const T &value_){
-    for (auto it = begin(); it != end(); it++) {
-      if (*it == value_) {
-        return it;
-      }
-    }
-    return end();
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::iterator sc::list<T, Alloc, Stats>::find(const T &value_){
+    return iterator{std::as_const(*this).find(value_).m_ptr};
   }
 
-  template <typename T>
-  void sc::list<T>::merge(list &other){
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::merge(list &other){
     if (this == &other) {
       return;
     }
 
-    Node *aux = m_head->next;
-    Node *aux2 = other.m_head->next;
+    node_base *aux = m_head.next;
+    node_base *aux2 = other.m_head.next;
 
-    while (aux != m_tail && aux2 != other.m_tail) {
-      if (aux->data < aux2->data) {
+    while (aux != &m_tail && aux2 != &other.m_tail) {
+      if (as_node(aux)->data < as_node(aux2)->data) {
         aux = aux->next;
       } else {
-        Node *aux3 = aux2->next;
+        node_base *aux3 = aux2->next;
         aux2->prev = aux->prev;
         aux2->next = aux;
         aux->prev->next = aux2;
@@ -1059,88 +1616,384 @@ inline bool operator!=(const sc::list<T> &l1_, const sc::list<T> &l2_) {
       }
     }
 
-    if (aux2 != other.m_tail) {
+    if (aux2 != &other.m_tail) {
       aux->prev->next = aux2;
       aux2->prev = aux->prev;
-      other.m_tail->prev->next = m_tail;
-      m_tail->prev = other.m_tail->prev;
+      other.m_tail.prev->next = &m_tail;
+      m_tail.prev = other.m_tail.prev;
       m_len += other.m_len;
     }
 
-    other.m_head->next = other.m_tail;
-    other.m_tail->prev = other.m_head;
+    other.m_head.next = &other.m_tail;
+    other.m_tail.prev = &other.m_head;
     other.m_len = 0;
+    // Positions moved on both sides.
+    m_finger = other.m_finger = nullptr;
+    Stats::on_grow(m_len);
   }
 
-  template <typename T>
-  void sc::list<T>::splice(const_iterator pos, list &other){
-    if (this == &other) {
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::splice(const_iterator pos, list &other){
+    if (this == &other || other.empty()) {
       return;
     }
 
-    Node *aux = pos.m_ptr;
-    Node *aux2 = other.m_head->next;
+    transfer(pos.m_ptr, other.m_head.next, other.m_tail.prev);
+    m_finger = other.m_finger = nullptr;
+    m_len += other.m_len;
+    other.m_len = 0;
+    Stats::on_grow(m_len);
+  }
 
-    while (aux2 != other.m_tail) {
-      Node *aux3 = aux2->next;
-      aux2->prev = aux->prev;
-      aux2->next = aux;
-      aux->prev->next = aux2;
-      aux->prev = aux2;
-      aux2 = aux3;
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::splice(const_iterator pos, list &other, const_iterator it){
+    node_base *node = it.m_ptr;
+    if (pos.m_ptr == node || pos.m_ptr == node->next) {
+      return;
+    }
+
+    transfer(pos.m_ptr, node, node);
+    m_finger = other.m_finger = nullptr;
+    if (this != &other) {
       ++m_len;
+      --other.m_len;
+      Stats::on_grow(m_len);
     }
+  }
 
-    other.m_head->next = other.m_tail;
-    other.m_tail->prev = other.m_head;
-    other.m_len = 0;
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::splice(const_iterator pos, list &other, const_iterator first, const_iterator last){
+    if (first == last) {
+      return;
+    }
+
+    if (this != &other) {
+      size_t count = 0;
+      for (auto it = first; it != last; ++it) {
+        ++count;
+      }
+      m_len += count;
+      other.m_len -= count;
+      Stats::on_grow(m_len);
+    }
+    transfer(pos.m_ptr, first.m_ptr, last.m_ptr->prev);
+    m_finger = other.m_finger = nullptr;
   }
 
-  template <typename T>
-  void sc::list<T>::reverse(){
-    list aux;
-    for (auto it = begin(); it != end(); it++) {
-      aux.push_front(*it);
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::transfer(node_base *pos, node_base *first, node_base *last){
+    detail::transfer(pos, first, last);
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::reverse(){
+    if (m_len <= 1) {
+      return;
+    }
+
+    node_base *first = m_head.next;
+    node_base *last = m_tail.prev;
+    // After the swap the old `next` is in `prev`, so that is where we keep walking.
+    for (node_base *runner = first; runner != &m_tail; runner = runner->prev) {
+      std::swap(runner->next, runner->prev);
     }
-    clear();
-    merge(aux);
+
+    m_head.next = last;
+    last->prev = &m_head;
+    m_tail.prev = first;
+    first->next = &m_tail;
+    m_finger = nullptr;
   }
 
-  template <typename T>
-  void sc::list<T>::sort(){
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::sort(){
+    sort([](const T &a, const T &b) { return a < b; });
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  template <typename Compare>
+  void sc::list<T, Alloc, Stats>::sort(Compare comp){
     if (m_len <= 1) {
       return;
     }
 
-    list left(m_len/2 - 1);
-    list right(m_len/2 + 1);
+    m_tail.prev->next = nullptr;
+    node_base *first = m_head.next;
+    try {
+      sort_chain(first, comp);
+    } catch (...) {
+      adopt_chain(first);
+      throw;
+    }
+    adopt_chain(first);
+  }
 
-    auto it = begin();
-    for (int i = 0; i < m_len / 2; i++) {
-      left.push_back(*it);
-      it++;
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::sort(const execution::parallel_policy &policy){
+    sort(policy, [](const T &a, const T &b) { return a < b; });
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  template <typename Compare>
+  void sc::list<T, Alloc, Stats>::sort(const execution::parallel_policy &policy, Compare comp){
+    size_t segments = std::min<size_t>(policy.thread_count(), m_len / 2);
+    if (m_len < policy.threshold || segments < 2) {
+      sort(comp);
+      return;
     }
-    for (int i = m_len / 2; i < m_len; i++) {
-      right.push_back(*it);
-      it++;
+
+    std::vector<node_base *> runs(segments);
+    std::vector<node_base *> merged(segments / 2);
+    std::vector<std::exception_ptr> errors(segments);
+
+    // Cut the list into `segments` null-terminated chains of (almost) equal length.
+    node_base *runner = m_head.next;
+    for (size_t i = 0; i < segments; ++i) {
+      size_t len = m_len / segments + (i < m_len % segments ? 1 : 0);
+      runs[i] = runner;
+      for (size_t k = 1; k < len; ++k) {
+        runner = runner->next;
+      }
+      node_base *next = runner->next;
+      runner->next = nullptr;
+      runner = next;
+    }
+
+    auto sort_job = [&runs, &comp](size_t i) {
+      Compare local{comp};
+      sort_chain(runs[i], local);
+    };
+    auto merge_job = [&runs, &merged, &comp](size_t i) {
+      Compare local{comp};
+      merge_chains(merged[i], runs[2 * i], runs[2 * i + 1], local);
+    };
+    // Every node is always reachable from `runs`, so a failure just glues the runs back.
+    auto recover = [this, &runs](size_t count) {
+      node_base *all = nullptr;
+      for (size_t i = count; i > 0; --i) {
+        all = concat_chains(runs[i - 1], all);
+      }
+      adopt_chain(all);
+    };
+
+    try {
+      detail::parallel_for(segments, sort_job, errors);
+      for (auto &error : errors) {
+        if (error) { std::rethrow_exception(error); }
+      }
+
+      // Merge neighbouring runs pairwise until a single run is left.
+      while (segments > 1) {
+        size_t pairs = segments / 2;
+        detail::parallel_for(pairs, merge_job, errors);
+        // Even a failed merge leaves all of its nodes in `merged[i]`.
+        std::copy(merged.begin(), merged.begin() + pairs, runs.begin());
+        if (segments % 2 == 1) {
+          runs[pairs] = runs[segments - 1];
+        }
+        segments = (segments + 1) / 2;
+        for (size_t i = 0; i < pairs; ++i) {
+          if (errors[i]) { std::rethrow_exception(errors[i]); }
+        }
+      }
+    } catch (...) {
+      recover(segments);
+      throw;
+    }
+    adopt_chain(runs[0]);
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  template <typename Compare>
+  void sc::list<T, Alloc, Stats>::merge_chains(node_base *&out, node_base *a, node_base *b, Compare &comp){
+    out = nullptr;
+    node_base **last = &out;
+    try {
+      while (a != nullptr && b != nullptr) {
+        if (comp(as_node(b)->data, as_node(a)->data)) {
+          *last = b;
+          b = b->next;
+        } else {
+          *last = a;
+          a = a->next;
+        }
+        last = &(*last)->next;
+      }
+    } catch (...) {
+      *last = concat_chains(a, b);
+      throw;
+    }
+    *last = (a != nullptr) ? a : b;
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  template <typename Compare>
+  void sc::list<T, Alloc, Stats>::sort_chain(node_base *&first, Compare &comp){
+    // bins[i] is empty or holds a sorted run of 2^i nodes; higher bins hold older nodes.
+    node_base *bins[64] = {};
+    size_t used = 0;
+    node_base *carry = nullptr;
+
+    try {
+      while (first != nullptr) {
+        carry = first;
+        first = first->next;
+        carry->next = nullptr;
+
+        size_t i = 0;
+        while (i < used && bins[i] != nullptr) {
+          node_base *run = bins[i];
+          bins[i] = nullptr;
+          merge_chains(carry, run, carry, comp);
+          ++i;
+        }
+        bins[i] = carry;
+        carry = nullptr;
+        if (i == used) {
+          ++used;
+        }
+      }
+
+      for (size_t i = 0; i < used; ++i) {
+        if (bins[i] != nullptr) {
+          node_base *run = bins[i];
+          bins[i] = nullptr;
+          merge_chains(carry, run, carry, comp);
+        }
+      }
+    } catch (...) {
+      // Hand every node back to the caller: the unprocessed ones, the carry and the bins.
+      first = concat_chains(carry, first);
+      for (size_t i = 0; i < used; ++i) {
+        first = concat_chains(bins[i], first);
+      }
+      throw;
     }
+    first = carry;
+  }
 
-    left.sort();
-    right.sort();
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::node_base *sc::list<T, Alloc, Stats>::concat_chains(node_base *a, node_base *b){
+    if (a == nullptr) {
+      return b;
+    }
+    node_base *last = a;
+    while (last->next != nullptr) {
+      last = last->next;
+    }
+    last->next = b;
+    return a;
+  }
 
-    if(left.end() == right.begin()){
-      left.pop_back();
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::adopt_chain(node_base *first){
+    node_base *prev = &m_head;
+    m_head.next = first;
+    for (node_base *runner = first; runner != nullptr; runner = runner->next) {
+      runner->prev = prev;
+      prev = runner;
     }
-    right.merge(left);
-    left.merge(right);
+    prev->next = &m_tail;
+    m_tail.prev = prev;
+    m_finger = nullptr;
   }
 
+  template <typename T, typename Alloc, typename Stats>
+  typename sc::list<T, Alloc, Stats>::size_type sc::list<T, Alloc, Stats>::remove(const T &value_){
+    auto equal = [&value_](const T &x) { return x == value_; };
+    return remove_nodes(equal, &value_);
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  template <typename Pred>
+  typename sc::list<T, Alloc, Stats>::size_type sc::list<T, Alloc, Stats>::remove_if(Pred pred){
+    return remove_nodes(pred, nullptr);
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  template <typename Pred>
+  typename sc::list<T, Alloc, Stats>::size_type sc::list<T, Alloc, Stats>::remove_nodes(Pred &pred, const T *spared){
+    reclaimer reclaim{*this};
+    node_base *kept = nullptr; // The node holding `*spared`, once unlinked.
+    size_type count = 0;
+    size_t visited = 0;
+    try {
+      for (node_base *runner = m_head.next; runner != &m_tail;) {
+        node_base *next = runner->next;
+        ++visited;
+        if (pred(as_node(runner)->data)) {
+          runner->prev->next = next;
+          next->prev = runner->prev;
+          --m_len;
+          ++count;
+          m_finger = nullptr;
+          if (&as_node(runner)->data == spared) {
+            kept = runner;
+          } else {
+            reclaim(runner);
+          }
+        }
+        runner = next;
+      }
+    } catch (...) {
+      // What was removed before `pred` threw stays removed.
+      if (kept != nullptr) { reclaim(kept); }
+      throw;
+    }
+    Stats::on_traverse(visited);
 
+    if (kept != nullptr) {
+      reclaim(kept);
+    }
+    return count;
+  }
 
+  template <typename T, typename Alloc, typename Stats>
+  template <typename Pred>
+  typename sc::list<T, Alloc, Stats>::iterator sc::list<T, Alloc, Stats>::stable_partition(const_iterator first, const_iterator last, Pred pred){
+    node_base *stop = last.m_ptr;
+    node_base rejected{nullptr, nullptr}; // Chain of the nodes that go after the partition point.
+    node_base *tail = &rejected;
+    size_t visited = 0;
+
+    // Hangs the rejected chain right before `stop`.
+    auto hang_rejected = [&]() {
+      if (tail == &rejected) {
+        return;
+      }
+      node_base *before = stop->prev;
+      before->next = rejected.next;
+      rejected.next->prev = before;
+      tail->next = stop;
+      stop->prev = tail;
+      m_finger = nullptr;
+    };
+
+    try {
+      for (node_base *runner = first.m_ptr; runner != stop;) {
+        node_base *next = runner->next;
+        ++visited;
+        if (!pred(as_node(runner)->data)) {
+          runner->prev->next = next;
+          next->prev = runner->prev;
+          tail->next = runner;
+          runner->prev = tail;
+          tail = runner;
+        }
+        runner = next;
+      }
+    } catch (...) {
+      hang_rejected();
+      throw;
+    }
+    Stats::on_traverse(visited);
 
+    hang_rejected();
+    return iterator{tail == &rejected ? stop : rejected.next};
+  }
 
-  template <typename T>
-  void sc::list<T>::unique(){
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::unique(){
     auto it = begin();
     while (it != end()) {
       auto it2 = it;
@@ -1151,3 +2004,97 @@ inline bool operator!=(const sc::list<T> &l1_, const sc::list<T> &l2_) {
       it++;
     }
   }
+
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::save(std::ostream &os_) const {
+    static_assert(std::is_trivially_copyable<T>::value, "save() requires a trivially copyable T");
+
+    detail::list_checksum sum;
+    for (auto it = cbegin(); it != cend(); ++it) {
+      sum.add(&*it, sizeof(T));
+    }
+    detail::list_file_header header{{}, m_len, sizeof(T), sum.value()};
+    std::memcpy(header.magic, detail::list_file_magic, sizeof(header.magic));
+    os_.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    const size_t chunk = io_buffer_bytes / sizeof(T) > 0 ? io_buffer_bytes / sizeof(T) : 1;
+    std::vector<unsigned char> buffer(chunk * sizeof(T));
+    size_t filled = 0;
+    for (auto it = cbegin(); it != cend() && os_; ++it) {
+      std::memcpy(buffer.data() + filled * sizeof(T), &*it, sizeof(T));
+      if (++filled == chunk) {
+        os_.write(reinterpret_cast<const char *>(buffer.data()), filled * sizeof(T));
+        filled = 0;
+      }
+    }
+    os_.write(reinterpret_cast<const char *>(buffer.data()), filled * sizeof(T));
+    if (!os_) {
+      throw std::runtime_error("Falha ao gravar a lista");
+    }
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::save(const std::string &path_) const {
+    std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      throw std::runtime_error("Não foi possível abrir o arquivo " + path_);
+    }
+    save(file);
+    file.close();
+    if (!file) {
+      throw std::runtime_error("Falha ao gravar a lista");
+    }
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::load(std::istream &is_) {
+    static_assert(std::is_trivially_copyable<T>::value, "load() requires a trivially copyable T");
+
+    detail::list_file_header header;
+    is_.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (is_.gcount() != static_cast<std::streamsize>(sizeof(header)) ||
+        std::memcmp(header.magic, detail::list_file_magic, sizeof(header.magic)) != 0) {
+      throw std::runtime_error("Os dados não são uma lista salva");
+    }
+    if (header.element_size != sizeof(T)) {
+      throw std::runtime_error("O tamanho dos elementos salvos não confere");
+    }
+
+    // Build aside and swap at the end, so a bad file leaves this list untouched.
+    list temp{allocator_type(m_alloc)};
+
+    // Typed storage, so every element in the buffer is properly aligned.
+    using raw = std::aligned_storage_t<sizeof(T), alignof(T)>;
+    const size_t chunk = io_buffer_bytes / sizeof(T) > 0 ? io_buffer_bytes / sizeof(T) : 1;
+    std::vector<raw> buffer(header.count < chunk ? header.count : chunk);
+    detail::list_checksum sum;
+    for (std::uint64_t left = header.count; left != 0;) {
+      size_t n = left < chunk ? static_cast<size_t>(left) : chunk;
+      is_.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(n * sizeof(T)));
+      if (is_.gcount() != static_cast<std::streamsize>(n * sizeof(T))) {
+        throw std::runtime_error("A lista salva está incompleta");
+      }
+      // Only for elements actually read: the count in the header may be damaged.
+      detail::reserve_nodes(temp.m_alloc, n);
+      for (size_t i{0}; i < n; ++i) {
+        sum.add(&buffer[i], sizeof(T));
+        temp.emplace_back(*std::launder(reinterpret_cast<const T *>(&buffer[i])));
+      }
+      left -= n;
+    }
+    if (sum.value() != header.checksum) {
+      throw std::runtime_error("O checksum da lista salva não confere");
+    }
+    swap(temp);
+  }
+
+  template <typename T, typename Alloc, typename Stats>
+  void sc::list<T, Alloc, Stats>::load(const std::string &path_) {
+    std::ifstream file(path_, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("Não foi possível abrir o arquivo " + path_);
+    }
+    load(file);
+  }
+
+#endif
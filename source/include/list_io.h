@@ -0,0 +1,81 @@
+#ifndef _LIST_IO_H_
+#define _LIST_IO_H_
+
+#include <cstddef>  // std::size_t
+#include <cstdint>  // std::uint64_t
+#include <cstring>  // std::memcpy
+#include <type_traits>
+#include <utility>  // std::declval
+
+namespace sc {
+namespace detail {
+/*!
+ *  Pieces of the binary format written by `list::save()` and read back by
+ *  `list::load()`. A file is a `list_file_header` followed by the raw bytes
+ *  of every element, in list order. Numbers are stored in the byte order of
+ *  the machine, so files are meant to be read back on the same platform.
+ */
+
+//! Identifies the format and its version.
+constexpr char list_file_magic[8] = {'S', 'C', 'L', 'I', 'S', 'T', '0', '1'};
+
+//! First bytes of a saved list.
+struct list_file_header {
+  char magic[8];              //!< Always `list_file_magic`.
+  std::uint64_t count;        //!< Number of elements.
+  std::uint64_t element_size; //!< `sizeof(T)` of the list that wrote the file.
+  std::uint64_t checksum;     //!< `list_checksum` of the element bytes.
+};
+
+/*!
+ *  \class list_checksum
+ *  \brief FNV-1a style hash of the element bytes, folded 8 bytes at a time.
+ *
+ *  Each element is hashed on its own (its last partial word padded with
+ *  zeros), so the result does not depend on how the elements are buffered.
+ */
+class list_checksum {
+public:
+  void add(const void *data, std::size_t n) {
+    const unsigned char *p = static_cast<const unsigned char *>(data);
+    for (; n >= 8; p += 8, n -= 8) {
+      std::uint64_t word;
+      std::memcpy(&word, p, 8);
+      fold(word);
+    }
+    if (n != 0) {
+      std::uint64_t word{0};
+      std::memcpy(&word, p, n);
+      fold(word);
+    }
+  }
+
+  std::uint64_t value() const { return m_hash; }
+
+private:
+  std::uint64_t m_hash{0xcbf29ce484222325ull};
+
+  void fold(std::uint64_t word) {
+    m_hash ^= word;
+    m_hash *= 0x100000001b3ull;
+  }
+};
+
+//! Whether an allocator can set aside room for many single objects up front.
+template <typename A, typename = void>
+struct has_reserve : std::false_type {};
+
+template <typename A>
+struct has_reserve<A, std::void_t<decltype(std::declval<A &>().reserve(std::size_t{}))>>
+    : std::true_type {};
+
+//! Asks `alloc` to prepare `n` single-object allocations, if it knows how to.
+template <typename A>
+void reserve_nodes(A &alloc, std::size_t n) {
+  if constexpr (has_reserve<A>::value) {
+    alloc.reserve(n);
+  }
+}
+} // namespace detail
+} // namespace sc
+#endif
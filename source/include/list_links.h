@@ -0,0 +1,43 @@
+#ifndef _LIST_LINKS_H_
+#define _LIST_LINKS_H_
+
+namespace sc {
+namespace detail {
+/*!
+ *  Pointer surgery shared by the doubly-linked containers. `Link` is any type
+ *  with `next` and `prev` pointers to `Link`; the lists keep a sentinel at each
+ *  end, so none of these functions has to test for null neighbours.
+ */
+
+//! Links the unlinked `node` right before `pos`.
+template <typename Link>
+void link_before(Link *pos, Link *node) {
+  node->prev = pos->prev;
+  node->next = pos;
+  pos->prev->next = node;
+  pos->prev = node;
+}
+
+//! Takes `node` out of its chain; its own links are left untouched.
+template <typename Link>
+void unlink(Link *node) {
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+}
+
+//! Unlinks the nodes [first, last] (both included) and links them back right before `pos`.
+template <typename Link>
+void transfer(Link *pos, Link *first, Link *last) {
+  // Close the gap left behind...
+  first->prev->next = last->next;
+  last->next->prev = first->prev;
+
+  // ... and open one before `pos`.
+  first->prev = pos->prev;
+  last->next = pos;
+  pos->prev->next = first;
+  pos->prev = last;
+}
+} // namespace detail
+} // namespace sc
+#endif
@@ -0,0 +1,132 @@
+#ifndef _LIST_STATS_H_
+#define _LIST_STATS_H_
+
+#include <atomic>  // std::atomic
+#include <cstddef> // std::size_t
+
+namespace sc {
+
+/*!
+ *  \struct stats_snapshot
+ *  \brief Plain copy of the counters kept by a statistics policy, ready to be exported.
+ */
+struct stats_snapshot {
+  std::size_t allocations = 0;     //!< Nodes allocated.
+  std::size_t deallocations = 0;   //!< Nodes freed.
+  std::size_t bytes_held = 0;      //!< Bytes of node storage currently owned.
+  std::size_t peak_size = 0;       //!< Largest number of elements held at once.
+  std::size_t nodes_traversed = 0; //!< Nodes visited by `find`, `erase(range)`, `at`/`nth` and iterator `+=`/`-=`.
+};
+
+/*!
+ *  \struct no_stats
+ *  \brief Default statistics policy: every hook is empty, so the counters compile to nothing.
+ *
+ *  A statistics policy is the third template argument of `sc::list`. The list
+ *  calls these hooks:
+ *  - `on_allocate(bytes)` / `on_deallocate(bytes)` for every node;
+ *  - `on_grow(size)` after its size increased to `size`;
+ *  - `on_traverse(nodes)` (const) when an operation walked over `nodes` nodes;
+ *  - the static `on_advance(nodes)` when an iterator jumped over `nodes` nodes.
+ *    Iterators do not know their list, so only global policies can count those.
+ *
+ *  `snapshot(size, node_bytes)` receives the current size of the list and the
+ *  size of one node, which per-list policies use to report the bytes held.
+ */
+struct no_stats {
+  void on_allocate(std::size_t) noexcept { /* empty */ }
+  void on_deallocate(std::size_t) noexcept { /* empty */ }
+  void on_grow(std::size_t) noexcept { /* empty */ }
+  void on_traverse(std::size_t) const noexcept { /* empty */ }
+  static void on_advance(std::size_t) noexcept { /* empty */ }
+
+  stats_snapshot snapshot(std::size_t, std::size_t) const noexcept { return {}; }
+};
+
+/*!
+ *  \struct local_stats
+ *  \brief Counts the operations of each list separately, with plain (non-atomic) counters.
+ *
+ *  Nodes handed over by `splice()` or `merge()` are owned by the receiving
+ *  list, so `bytes_held` is derived from the current size rather than from
+ *  the allocation counters. Iterator jumps are not counted.
+ */
+struct local_stats {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t peak_size = 0;
+  mutable std::size_t nodes_traversed = 0; //!< Also counted by `find() const`.
+
+  void on_allocate(std::size_t) noexcept { ++allocations; }
+  void on_deallocate(std::size_t) noexcept { ++deallocations; }
+  void on_grow(std::size_t size) noexcept {
+    if (size > peak_size) { peak_size = size; }
+  }
+  void on_traverse(std::size_t nodes) const noexcept { nodes_traversed += nodes; }
+  static void on_advance(std::size_t) noexcept { /* empty */ }
+
+  stats_snapshot snapshot(std::size_t size, std::size_t node_bytes) const noexcept {
+    return {allocations, deallocations, size * node_bytes, peak_size, nodes_traversed};
+  }
+};
+
+/*!
+ *  \struct global_stats
+ *  \brief Counts the operations of every list using this policy in shared atomic counters.
+ *
+ *  Counters are updated with relaxed atomics, so lists may be used from
+ *  several threads. `peak_size` is the largest number of live nodes across
+ *  all those lists. Use different `Tag` types to keep separate sets of counters,
+ *  e.g. one per subsystem.
+ *
+ *  \tparam Tag Any type; each distinct tag owns its own counters.
+ */
+template <typename Tag = void>
+struct global_stats {
+  static inline std::atomic<std::size_t> allocations{0};
+  static inline std::atomic<std::size_t> deallocations{0};
+  static inline std::atomic<std::size_t> bytes_held{0};
+  static inline std::atomic<std::size_t> live_nodes{0};
+  static inline std::atomic<std::size_t> peak_size{0};
+  static inline std::atomic<std::size_t> nodes_traversed{0};
+
+  void on_allocate(std::size_t bytes) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_held.fetch_add(bytes, std::memory_order_relaxed);
+    std::size_t live = live_nodes.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::size_t peak = peak_size.load(std::memory_order_relaxed);
+    while (live > peak && !peak_size.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+      // `peak` was reloaded by the failed exchange.
+    }
+  }
+  void on_deallocate(std::size_t bytes) noexcept {
+    deallocations.fetch_add(1, std::memory_order_relaxed);
+    bytes_held.fetch_sub(bytes, std::memory_order_relaxed);
+    live_nodes.fetch_sub(1, std::memory_order_relaxed);
+  }
+  void on_grow(std::size_t) noexcept { /* empty */ }
+  void on_traverse(std::size_t nodes) const noexcept { on_advance(nodes); }
+  static void on_advance(std::size_t nodes) noexcept {
+    nodes_traversed.fetch_add(nodes, std::memory_order_relaxed);
+  }
+
+  stats_snapshot snapshot(std::size_t, std::size_t) const noexcept { return global_snapshot(); }
+
+  //! Returns the counters without needing a list.
+  static stats_snapshot global_snapshot() noexcept {
+    return {allocations.load(std::memory_order_relaxed), deallocations.load(std::memory_order_relaxed),
+            bytes_held.load(std::memory_order_relaxed), peak_size.load(std::memory_order_relaxed),
+            nodes_traversed.load(std::memory_order_relaxed)};
+  }
+
+  //! Zeroes the counters, except for what is still alive: the peak restarts from the live nodes.
+  static void reset() noexcept {
+    allocations.store(0, std::memory_order_relaxed);
+    deallocations.store(0, std::memory_order_relaxed);
+    peak_size.store(live_nodes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    nodes_traversed.store(0, std::memory_order_relaxed);
+  }
+};
+
+} // namespace sc
+#endif
@@ -0,0 +1,137 @@
+#ifndef _LRU_CACHE_H_
+#define _LRU_CACHE_H_
+
+#include <cstddef>   // std::size_t
+#include <functional>
+#include <stdexcept> // std::invalid_argument
+#include <utility>   // std::move, std::forward
+
+#include "indexed_list.h"
+
+namespace sc {
+
+/*!
+ *  \class lru_cache
+ *  \brief Fixed-capacity key/value cache that evicts the least recently used entry.
+ *
+ *  Entries live in an `sc::indexed_list`, most recently used first, so a
+ *  lookup is one hash probe and a hit moves the entry to the front by
+ *  relinking its node: no allocation, no copy. Inserting into a full cache
+ *  evicts the entry at the back. Nodes come from the slab pool, so the node
+ *  freed by an eviction is the one reused by the insertion that caused it.
+ *
+ *  \tparam K The type of the keys.
+ *  \tparam V The type of the cached values.
+ *  \tparam Hash Hash function of the keys.
+ *  \tparam KeyEqual Equality of the keys.
+ *  \tparam Alloc The allocator used for the entry nodes (rebound to the node type).
+ */
+template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<>,
+          typename Alloc = sc::pool_allocator<K>>
+class lru_cache {
+public:
+  //! A cached entry. The index only looks at the key, so the value may change in place.
+  struct entry {
+    K key;
+    mutable V value;
+  };
+
+private:
+  struct key_of {
+    const K &operator()(const entry &e) const noexcept { return e.key; }
+  };
+  using list_type = sc::indexed_list<entry, key_of, Hash, KeyEqual, Alloc>;
+
+public:
+  using key_type = K;
+  using mapped_type = V;
+  using size_type = std::size_t;
+  using const_iterator = typename list_type::const_iterator; //!< Walks from most to least recently used.
+
+  /*!
+   *  Constructs an empty cache.
+   *  \param capacity The maximum number of entries.
+   *  \throw std::invalid_argument if `capacity` is zero.
+   */
+  explicit lru_cache(size_type capacity) : m_capacity(capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("A capacidade deve ser positiva");
+    }
+  }
+
+  //=== Lookup
+  /*!
+   *  Looks `key` up and, on a hit, makes it the most recently used entry.
+   *  \return A pointer to the cached value, or nullptr on a miss.
+   */
+  V *get(const K &key) {
+    const_iterator it = m_entries.find(key);
+    if (it == m_entries.cend()) {
+      ++m_misses;
+      return nullptr;
+    }
+    ++m_hits;
+    m_entries.splice(m_entries.cbegin(), m_entries, it);
+    return &it->value;
+  }
+
+  //! Returns true if `key` is cached; neither the order nor the counters change.
+  bool contains(const K &key) const { return m_entries.contains(key); }
+
+  //=== Modifiers
+  /*!
+   *  Caches `value` under `key` as the most recently used entry, replacing
+   *  the value already cached under `key`, if any. When a new key arrives
+   *  at a full cache, the least recently used entry is evicted first.
+   *  \return A reference to the cached value.
+   */
+  template <typename U>
+  V &put(const K &key, U &&value) {
+    const_iterator it = m_entries.find(key);
+    if (it != m_entries.cend()) {
+      it->value = std::forward<U>(value);
+      m_entries.splice(m_entries.cbegin(), m_entries, it);
+      return it->value;
+    }
+    if (m_entries.size() == m_capacity) {
+      m_entries.pop_back();
+      ++m_evictions;
+    }
+    return m_entries.emplace_front(entry{key, V(std::forward<U>(value))}).value;
+  }
+
+  /*!
+   *  Removes `key` from the cache.
+   *  \return True if an entry was removed.
+   */
+  bool erase(const K &key) { return m_entries.erase(key) != 0; }
+
+  //! Removes every entry; the counters are kept.
+  void clear() { m_entries.clear(); }
+
+  //=== Status
+  [[nodiscard]] bool empty() const { return m_entries.empty(); }
+  [[nodiscard]] size_type size() const { return m_entries.size(); }
+  [[nodiscard]] size_type capacity() const { return m_capacity; }
+
+  const_iterator begin() const { return m_entries.cbegin(); }
+  const_iterator end() const { return m_entries.cend(); }
+
+  //=== Counters
+  size_type hits() const { return m_hits; }           //!< Calls to get() that found their key.
+  size_type misses() const { return m_misses; }       //!< Calls to get() that did not.
+  size_type evictions() const { return m_evictions; } //!< Entries dropped to make room.
+
+  //! Sets every counter back to zero.
+  void reset_counters() { m_hits = m_misses = m_evictions = 0; }
+
+private:
+  list_type m_entries;      //!< Most recently used first.
+  size_type m_capacity;     //!< Maximum number of entries.
+  size_type m_hits{0};
+  size_type m_misses{0};
+  size_type m_evictions{0};
+};
+
+} // namespace sc
+#endif
@@ -0,0 +1,659 @@
+#ifndef _MAPPED_LIST_H_
+#define _MAPPED_LIST_H_
+
+#include <cerrno>       // errno
+#include <cstddef>      // std::size_t, std::ptrdiff_t
+#include <cstdint>      // std::uint64_t
+#include <cstring>      // std::memcpy, std::memcmp
+#include <initializer_list>
+#include <iterator>     // bidirectional_iterator_tag
+#include <stdexcept>    // std::logic_error, std::out_of_range, std::runtime_error
+#include <string>
+#include <system_error> // std::system_error
+#include <type_traits>
+#include <utility>      // std::swap
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, msync, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close, ftruncate
+
+namespace sc {
+
+/*!
+ *  \class mapped_list
+ *  \brief Doubly-linked list whose nodes live in a memory-mapped file.
+ *
+ *  The links are byte offsets from the start of the file rather than
+ *  pointers, so the file means the same thing wherever it is mapped:
+ *  opening an existing file maps it and the list is ready, in O(1) no matter
+ *  how long it is. The file starts with a header holding the size, the
+ *  sentinel and the free list; nodes are carved from the end of the used
+ *  area and the file (and its mapping) grows in chunks when it runs out.
+ *  Erased nodes go on a free list kept in the file, so they are reused.
+ *
+ *  Changes reach the file through the shared mapping; `flush()` waits until
+ *  they are on disk. Nothing is journaled: a crash before `flush()` may
+ *  leave a file that does not reopen.
+ *
+ *  Iterators hold offsets, so they stay valid when the mapping grows and
+ *  moves; pointers and references to elements do not.
+ *
+ *  A moved-from list has no file: `is_open()` is false, it reads as empty,
+ *  and inserting into it throws until another list is moved into it.
+ *
+ *  \note POSIX only (`mmap`). The file stores numbers in the byte order of
+ *  the machine, so it is not portable across platforms.
+ *
+ *  \tparam T The type of the elements; must be trivially copyable.
+ */
+template <typename T>
+class mapped_list {
+  static_assert(std::is_trivially_copyable<T>::value, "mapped_list requires a trivially copyable T");
+
+  using offset = std::uint64_t;
+
+  //! The links of a node, as offsets. The sentinel is a bare `link` inside the header.
+  struct link {
+    offset next;
+    offset prev;
+  };
+
+  //! A node: its links plus the element.
+  struct node : link {
+    T data;
+  };
+
+  //! The first bytes of the file.
+  struct header {
+    char magic[8];             //!< Identifies the format.
+    std::uint64_t value_size;  //!< `sizeof(T)` of the list that created the file.
+    std::uint64_t node_size;   //!< `sizeof(node)` of the list that created the file.
+    std::uint64_t file_size;   //!< Bytes in the file, which are all mapped.
+    std::uint64_t size;        //!< Number of elements.
+    std::uint64_t used;        //!< Offset of the first byte never handed out.
+    offset free_head;          //!< First node of the free list (linked by `next`), or 0.
+    link root;                 //!< The sentinel: before the first and after the last element.
+  };
+
+  static constexpr char file_magic[8] = {'S', 'C', 'M', 'A', 'P', 'L', '0', '1'};
+  static constexpr offset root_offset = offsetof(header, root);
+  //! Nodes start after the header, at a multiple of their alignment.
+  static constexpr offset first_node = (sizeof(header) + alignof(node) - 1) / alignof(node) * alignof(node);
+  //! The file grows by at least this many bytes at a time.
+  static constexpr std::uint64_t growth_chunk = 1 << 20;
+
+  /*!
+   *  \class iterator_impl
+   *  \brief Bidirectional iterator over a mapped list.
+   *  \tparam Const Whether this iterator gives read-only access.
+   */
+  template <bool Const>
+  class iterator_impl {
+  public:
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+  private:
+    using owner = std::conditional_t<Const, const mapped_list, mapped_list>;
+    owner *m_list; //!< The list, whose mapping may move.
+    offset m_off;  //!< Offset of the current node.
+
+  public:
+    iterator_impl(owner *list = nullptr, offset off = 0) : m_list{list}, m_off{off} { }
+
+    //! A mutable iterator converts to a const one.
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    iterator_impl(const iterator_impl<false> &other) : m_list{other.m_list}, m_off{other.m_off} { }
+
+    reference operator*() const { return m_list->node_at(m_off)->data; }
+    pointer operator->() const { return &m_list->node_at(m_off)->data; }
+
+    iterator_impl &operator++() {
+      m_off = m_list->link_at(m_off)->next;
+      return *this;
+    }
+
+    iterator_impl operator++(int) {
+      iterator_impl temp{*this};
+      ++*this;
+      return temp;
+    }
+
+    iterator_impl &operator--() {
+      m_off = m_list->link_at(m_off)->prev;
+      return *this;
+    }
+
+    iterator_impl operator--(int) {
+      iterator_impl temp{*this};
+      --*this;
+      return temp;
+    }
+
+    bool operator==(const iterator_impl &rhs) const { return m_off == rhs.m_off; }
+    bool operator!=(const iterator_impl &rhs) const { return m_off != rhs.m_off; }
+
+    friend class mapped_list;
+    friend class iterator_impl<!Const>;
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = iterator_impl<false>;      //!< Mutable iterator.
+  using const_iterator = iterator_impl<true>; //!< Read-only iterator.
+
+  //=== [I] Special members
+  /*!
+   *  Opens the list stored in `path`, creating an empty one if the file does
+   *  not exist or is empty.
+   *
+   *  \throw std::system_error if the file cannot be opened or mapped.
+   *  \throw std::runtime_error if the file is not a list with this element type.
+   */
+  explicit mapped_list(const std::string &path) {
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (m_fd < 0) {
+      throw std::system_error(errno, std::generic_category(), "Não foi possível abrir " + path);
+    }
+    try {
+      struct stat info;
+      if (::fstat(m_fd, &info) != 0) {
+        throw std::system_error(errno, std::generic_category(), "Não foi possível ler " + path);
+      }
+      if (info.st_size == 0) {
+        create();
+      } else {
+        open_existing(static_cast<std::uint64_t>(info.st_size));
+      }
+    } catch (...) {
+      unmap();
+      ::close(m_fd);
+      throw;
+    }
+  }
+
+  //! Takes over the file of `other`, which is left with no file (see `is_open()`).
+  mapped_list(mapped_list &&other) noexcept { swap(other); }
+
+  //! Closes the current file and takes over the one of `rhs`, which is left with no file.
+  mapped_list &operator=(mapped_list &&rhs) noexcept {
+    if (this != &rhs) {
+      mapped_list temp{std::move(rhs)};
+      swap(temp);
+    }
+    return *this;
+  }
+
+  // Two objects writing the same mapping would corrupt it.
+  mapped_list(const mapped_list &) = delete;
+  mapped_list &operator=(const mapped_list &) = delete;
+
+  //! Unmaps the file; the kernel writes back pending changes in its own time.
+  ~mapped_list() {
+    unmap();
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+  }
+
+  void swap(mapped_list &other) noexcept {
+    std::swap(m_fd, other.m_fd);
+    std::swap(m_base, other.m_base);
+    std::swap(m_mapped, other.m_mapped);
+  }
+
+  //=== [II] Iterators
+  iterator begin() { return iterator{this, first_offset()}; }
+  iterator end() { return iterator{this, root_offset}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_iterator cbegin() const { return const_iterator{this, first_offset()}; }
+  const_iterator cend() const { return const_iterator{this, root_offset}; }
+
+  //=== [III] Capacity/Status
+  [[nodiscard]] bool empty() const { return size() == 0; }
+  [[nodiscard]] size_type size() const { return is_open() ? static_cast<size_type>(hdr()->size) : 0; }
+
+  //! Returns false for a list that was moved from, which has no file.
+  [[nodiscard]] bool is_open() const { return m_base != nullptr; }
+
+  //! Returns the size of the file, which is also the size of the mapping; 0 without a file.
+  std::uint64_t file_size() const { return is_open() ? hdr()->file_size : 0; }
+
+  //=== [IV] Access
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &front() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *begin();
+  }
+
+  const T &front() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *cbegin();
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &back() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *--end();
+  }
+
+  const T &back() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *--cend();
+  }
+
+  //=== [V] Modifiers
+  void push_front(const T &value_) { insert(cbegin(), value_); }
+  void push_back(const T &value_) { insert(cend(), value_); }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_front() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(cbegin());
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_back() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(--cend());
+  }
+
+  /*!
+   *  Inserts a copy of `value_` right before `pos`.
+   *  \return An iterator to the new element.
+   *  \throw std::system_error if the file has to grow and cannot.
+   *  \throw std::logic_error if the list has no file.
+   */
+  iterator insert(const_iterator pos, const T &value_) {
+    if (!is_open()) {
+      throw std::logic_error("A lista não tem arquivo");
+    }
+    T copy = value_; // `value_` may live in the mapping, which may move.
+    offset off = allocate_node();
+    node *n = node_at(off);
+    std::memcpy(static_cast<void *>(&n->data), &copy, sizeof(T));
+    link *at = link_at(pos.m_off);
+    n->next = pos.m_off;
+    n->prev = at->prev;
+    link_at(at->prev)->next = off;
+    at->prev = off;
+    ++hdr()->size;
+    return iterator{this, off};
+  }
+
+  /*!
+   *  Inserts the elements of [first, last) right before `pos`.
+   *  \return An iterator to the first inserted element, or `pos` if the range is empty.
+   */
+  template <typename InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    iterator result{this, pos.m_off};
+    bool first_one = true;
+    for (; first != last; ++first) {
+      iterator it = insert(pos, *first);
+      if (first_one) {
+        result = it;
+        first_one = false;
+      }
+    }
+    return result;
+  }
+
+  /*!
+   *  Removes the element at `pos`; its node goes on the free list.
+   *  \return An iterator to the element that followed it.
+   */
+  iterator erase(const_iterator pos) {
+    link *n = link_at(pos.m_off);
+    offset next = n->next;
+    link_at(n->prev)->next = next;
+    link_at(next)->prev = n->prev;
+    n->next = hdr()->free_head;
+    hdr()->free_head = pos.m_off;
+    --hdr()->size;
+    return iterator{this, next};
+  }
+
+  //! Removes the elements of [first, last).
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) {
+      first = erase(first);
+    }
+    return iterator{this, last.m_off};
+  }
+
+  //! Removes every element, in O(1): the whole chain joins the free list.
+  void clear() {
+    if (empty()) {
+      return;
+    }
+    link *r = root();
+    link_at(r->prev)->next = hdr()->free_head;
+    hdr()->free_head = r->next;
+    r->next = r->prev = root_offset;
+    hdr()->size = 0;
+  }
+
+  //=== [VI] Operations
+  //! Finds the first element equal to `value_`, or returns end().
+  iterator find(const T &value_) {
+    iterator it = begin();
+    while (it != end() && !(*it == value_)) {
+      ++it;
+    }
+    return it;
+  }
+
+  //! Reverses the order of the elements by swapping the links of every node.
+  void reverse() {
+    if (empty()) {
+      return;
+    }
+    offset off = root_offset;
+    do {
+      link *l = link_at(off);
+      std::swap(l->next, l->prev);
+      off = l->prev; // The old `next`.
+    } while (off != root_offset);
+  }
+
+  /*!
+   *  Moves every element of `other` into this list, before `pos`.
+   *  Nodes cannot leave their file, so the elements are copied into this
+   *  file and `other` is then cleared, in O(1).
+   */
+  void splice(const_iterator pos, mapped_list &other) {
+    if (&other == this) {
+      return;
+    }
+    insert(pos, other.cbegin(), other.cend());
+    other.clear();
+  }
+
+  /*!
+   *  Moves the elements of [first, last) from `other` into this list, before `pos`.
+   *  Within the same list only the boundary nodes are relinked, in O(1);
+   *  from another list the elements are copied and then erased there.
+   */
+  void splice(const_iterator pos, mapped_list &other, const_iterator first, const_iterator last) {
+    if (first == last) {
+      return;
+    }
+    if (&other != this) {
+      insert(pos, first, last);
+      other.erase(first, last);
+      return;
+    }
+    if (pos == last) {
+      return;
+    }
+    offset head = first.m_off;
+    offset tail = link_at(last.m_off)->prev;
+    // Cut [first, last) out...
+    link_at(link_at(head)->prev)->next = last.m_off;
+    link_at(last.m_off)->prev = link_at(head)->prev;
+    // ...and hang it before `pos`.
+    link *at = link_at(pos.m_off);
+    link_at(at->prev)->next = head;
+    link_at(head)->prev = at->prev;
+    link_at(tail)->next = pos.m_off;
+    at->prev = tail;
+  }
+
+  /*!
+   *  Merges the sorted list `other` into this sorted list; equal elements of
+   *  this list come first. The elements of `other` are copied into this file
+   *  at their place, in one pass over both lists, and `other` is cleared.
+   */
+  void merge(mapped_list &other) {
+    if (&other == this) {
+      return;
+    }
+    const_iterator pos = cbegin();
+    for (const_iterator it = other.cbegin(); it != other.cend(); ++it) {
+      while (pos != cend() && !(*it < *pos)) {
+        ++pos;
+      }
+      insert(pos, *it);
+    }
+    other.clear();
+  }
+
+  //! Removes every element equal to the one before it; the nodes go on the free list.
+  void unique() {
+    if (empty()) {
+      return;
+    }
+    const_iterator prev = cbegin();
+    const_iterator it = std::next(prev);
+    while (it != cend()) {
+      if (*it == *prev) {
+        it = erase(it);
+      } else {
+        prev = it++;
+      }
+    }
+  }
+
+  //! Sorts the list in non-descending order (stable, only relinks nodes).
+  void sort() {
+    sort([](const T &a, const T &b) { return a < b; });
+  }
+
+  /*!
+   *  Sorts the list according to `comp` with a bottom-up merge sort. The
+   *  sort is stable, never allocates and never copies elements: only the
+   *  offsets in the nodes change, so iterators remain valid.
+   *  \note `comp` must not throw: the links are rewritten in place, in the file.
+   */
+  template <typename Compare>
+  void sort(Compare comp) {
+    if (size() < 2) {
+      return;
+    }
+    // Work on a chain linked by `next` only and ended by 0, which no node uses.
+    offset head = root()->next;
+    link_at(root()->prev)->next = 0;
+    for (size_type width{1};; width *= 2) {
+      offset merged = 0;
+      offset *tail = &merged;
+      size_type runs{0};
+      offset left = head;
+      while (left != 0) {
+        ++runs;
+        offset right = left;
+        size_type left_len{0};
+        while (left_len < width && right != 0) {
+          ++left_len;
+          right = link_at(right)->next;
+        }
+        size_type right_len{width};
+        while (left_len > 0 || (right_len > 0 && right != 0)) {
+          offset taken;
+          if (left_len > 0 && (right_len == 0 || right == 0 || !comp(node_at(right)->data, node_at(left)->data))) {
+            taken = left;
+            left = link_at(left)->next;
+            --left_len;
+          } else {
+            taken = right;
+            right = link_at(right)->next;
+            --right_len;
+          }
+          *tail = taken;
+          tail = &link_at(taken)->next;
+        }
+        left = right;
+      }
+      *tail = 0;
+      head = merged;
+      if (runs <= 1) {
+        break;
+      }
+    }
+    // Rebuild the `prev` links and close the ring through the sentinel.
+    offset prev = root_offset;
+    for (offset off = head; off != 0; off = link_at(off)->next) {
+      link_at(off)->prev = prev;
+      prev = off;
+    }
+    root()->next = head;
+    root()->prev = prev;
+    link_at(prev)->next = root_offset;
+  }
+
+  /*!
+   *  Blocks until every change made so far is written to the file.
+   *  \throw std::system_error if the kernel reports a write error.
+   */
+  void flush() {
+    if (is_open() && ::msync(m_base, m_mapped, MS_SYNC) != 0) {
+      throw std::system_error(errno, std::generic_category(), "Falha ao sincronizar a lista");
+    }
+  }
+
+private:
+  int m_fd{-1};                    //!< The open file.
+  unsigned char *m_base{nullptr};  //!< Start of the mapping.
+  std::uint64_t m_mapped{0};       //!< Bytes mapped.
+
+  header *hdr() const { return reinterpret_cast<header *>(m_base); }
+  link *root() const { return &hdr()->root; }
+  //! Offset of the first node, or of the sentinel when the list is empty or has no file.
+  offset first_offset() const { return is_open() ? root()->next : root_offset; }
+  link *link_at(offset off) const { return reinterpret_cast<link *>(m_base + off); }
+  node *node_at(offset off) const { return reinterpret_cast<node *>(m_base + off); }
+
+  //! Maps `bytes` of the file, replacing any previous mapping.
+  void map(std::uint64_t bytes) {
+    void *p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (p == MAP_FAILED) {
+      throw std::system_error(errno, std::generic_category(), "Falha ao mapear a lista");
+    }
+    unmap();
+    m_base = static_cast<unsigned char *>(p);
+    m_mapped = bytes;
+  }
+
+  void unmap() noexcept {
+    if (m_base != nullptr) {
+      ::munmap(m_base, m_mapped);
+      m_base = nullptr;
+      m_mapped = 0;
+    }
+  }
+
+  //! Lays out an empty list in a brand new file.
+  void create() {
+    resize_file(growth_chunk);
+    map(growth_chunk);
+    header *h = hdr();
+    std::memcpy(h->magic, file_magic, sizeof(file_magic));
+    h->value_size = sizeof(T);
+    h->node_size = sizeof(node);
+    h->file_size = growth_chunk;
+    h->size = 0;
+    h->used = first_node;
+    h->free_head = 0;
+    h->root.next = h->root.prev = root_offset;
+  }
+
+  //! Whether `off` can be the offset of a node below `used`.
+  static bool is_node_offset(offset off, std::uint64_t used) {
+    return off >= first_node && off < used && used - off >= sizeof(node) && (off - first_node) % sizeof(node) == 0;
+  }
+
+  /*!
+   *  Maps a file written before and checks that it holds a list of this type.
+   *  The header's offsets are checked against the file, so a damaged header
+   *  cannot send the list outside the mapping; the links inside the nodes are
+   *  not walked, which keeps opening O(1).
+   */
+  void open_existing(std::uint64_t bytes) {
+    if (bytes < sizeof(header)) {
+      throw std::runtime_error("O arquivo não contém uma lista mapeada");
+    }
+    map(bytes);
+    const header *h = hdr();
+    if (std::memcmp(h->magic, file_magic, sizeof(file_magic)) != 0) {
+      throw std::runtime_error("O arquivo não contém uma lista mapeada");
+    }
+    if (h->value_size != sizeof(T) || h->node_size != sizeof(node)) {
+      throw std::runtime_error("O tamanho dos elementos do arquivo não confere");
+    }
+    if (h->file_size != bytes || h->used > bytes || first_node > h->used ||
+        (h->used - first_node) % sizeof(node) != 0 ||
+        h->size > (h->used - first_node) / sizeof(node) ||
+        (h->free_head != 0 && !is_node_offset(h->free_head, h->used))) {
+      throw std::runtime_error("O arquivo da lista está corrompido");
+    }
+    for (offset end : {h->root.next, h->root.prev}) {
+      if (end != root_offset && !is_node_offset(end, h->used)) {
+        throw std::runtime_error("O arquivo da lista está corrompido");
+      }
+    }
+    if ((h->size == 0) != (h->root.next == root_offset) ||
+        (h->root.next == root_offset) != (h->root.prev == root_offset)) {
+      throw std::runtime_error("O arquivo da lista está corrompido");
+    }
+  }
+
+  void resize_file(std::uint64_t bytes) {
+    if (::ftruncate(m_fd, static_cast<off_t>(bytes)) != 0) {
+      throw std::system_error(errno, std::generic_category(), "Falha ao aumentar o arquivo da lista");
+    }
+  }
+
+  //! Returns a free node, from the free list or from the unused end of the file.
+  offset allocate_node() {
+    header *h = hdr();
+    if (h->free_head != 0) {
+      offset off = h->free_head;
+      h->free_head = link_at(off)->next;
+      return off;
+    }
+    if (h->used + sizeof(node) > h->file_size) {
+      grow(h->used + sizeof(node));
+      h = hdr();
+    }
+    offset off = h->used;
+    h->used += sizeof(node);
+    return off;
+  }
+
+  //! Grows the file and the mapping to at least `needed` bytes; doubles, in whole chunks.
+  void grow(std::uint64_t needed) {
+    std::uint64_t bytes = hdr()->file_size * 2;
+    if (bytes < needed) {
+      bytes = needed;
+    }
+    bytes = (bytes + growth_chunk - 1) / growth_chunk * growth_chunk;
+    std::uint64_t old_bytes = hdr()->file_size;
+    resize_file(bytes);
+    try {
+      map(bytes);
+    } catch (...) {
+      // Keep the file in step with its header, so it still opens.
+      (void)::ftruncate(m_fd, static_cast<off_t>(old_bytes));
+      throw;
+    }
+    hdr()->file_size = bytes;
+  }
+};
+
+} // namespace sc
+#endif
@@ -0,0 +1,158 @@
+#ifndef _MPSC_LIST_H_
+#define _MPSC_LIST_H_
+
+#include <atomic>   // std::atomic
+#include <cstddef>  // std::size_t
+#include <memory>   // std::allocator_traits
+#include <new>      // std::launder
+#include <optional> // std::optional
+#include <utility>  // std::move, std::forward
+
+#include "list.h"
+#include "pool_allocator.h"
+
+namespace sc {
+
+/*!
+ *  \class mpsc_list
+ *  \brief Lock-free FIFO queue with many producer threads and one consumer thread.
+ *
+ *  Producers call `push_back()` / `emplace_back()` concurrently; each push is
+ *  wait-free (one atomic exchange). A single consumer thread at a time calls
+ *  `pop_front()` or `drain()`. Nodes come from the same slab pool as
+ *  `sc::list`, so pushing does not take the heap lock either.
+ *
+ *  Elements pushed by one producer come out in the order they were pushed.
+ *
+ *  \note A producer links its node in two steps. While it sits between them,
+ *  the consumer sees the queue end right before that node, so `pop_front()`
+ *  may report an empty queue even though a push has already started.
+ *
+ *  \tparam T The type of the queued elements.
+ *  \tparam Alloc The allocator used for the nodes (rebound to the node type).
+ */
+template <typename T, typename Alloc = sc::pool_allocator<T>>
+class mpsc_list {
+private:
+  //! A queue node: an atomic link plus room for one element.
+  struct Node {
+    std::atomic<Node *> next{nullptr};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T *value() { return std::launder(reinterpret_cast<T *>(storage)); }
+  };
+
+  using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = Alloc;
+
+  //! \brief Constructs an empty queue.
+  mpsc_list() {
+    Node *stub = create_node();
+    m_back.store(stub, std::memory_order_relaxed);
+    m_front = stub;
+  }
+
+  mpsc_list(const mpsc_list &) = delete;
+  mpsc_list &operator=(const mpsc_list &) = delete;
+
+  //! Destroys the queued elements. No producer may be running.
+  ~mpsc_list() {
+    while (pop_front()) { /* empty */ }
+    destroy_node(m_front);
+  }
+
+  /*!
+   *  Appends a copy of `value`. Safe to call from any number of threads.
+   *  \param value The value to be appended.
+   */
+  void push_back(const T &value) { emplace_back(value); }
+
+  //! Appends `value` by moving it. Safe to call from any number of threads.
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  /*!
+   *  Appends an element constructed in place from `args`. Safe to call from any number of threads.
+   *  \param args Arguments forwarded to the constructor of T.
+   */
+  template <typename... Args>
+  void emplace_back(Args &&...args) {
+    Node *node = create_node();
+    try {
+      ::new (static_cast<void *>(node->storage)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      destroy_node(node);
+      throw;
+    }
+    // Publish the node: claim the back slot, then link the previous back to it.
+    Node *prev = m_back.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  /*!
+   *  Removes the first element. Consumer thread only.
+   *  \return The element, or an empty optional if no element is ready.
+   */
+  std::optional<T> pop_front() {
+    Node *next = m_front->next.load(std::memory_order_acquire);
+    if (next == nullptr) {
+      return std::nullopt;
+    }
+    std::optional<T> result{std::move(*next->value())};
+    next->value()->~T();
+    // `next` becomes the new stub, whose storage is considered empty.
+    destroy_node(m_front);
+    m_front = next;
+    return result;
+  }
+
+  /*!
+   *  Moves every element that is ready to the end of `out`. Consumer thread only.
+   *  \param out The list receiving the elements.
+   *  \return The number of elements moved.
+   */
+  template <typename OutAlloc, typename Stats>
+  size_type drain(sc::list<T, OutAlloc, Stats> &out) {
+    size_type count = 0;
+    for (Node *next = m_front->next.load(std::memory_order_acquire); next != nullptr;
+         next = m_front->next.load(std::memory_order_acquire)) {
+      out.push_back(std::move(*next->value()));
+      next->value()->~T();
+      destroy_node(m_front);
+      m_front = next;
+      ++count;
+    }
+    return count;
+  }
+
+  //! Returns true if no element is ready for the consumer. Consumer thread only.
+  [[nodiscard]] bool empty() const {
+    return m_front->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  // Producers hammer `m_back`; keep it away from the consumer's `m_front`.
+  alignas(64) std::atomic<Node *> m_back; //!< Last linked node; producers exchange it.
+  alignas(64) Node *m_front;              //!< Stub node before the first element; consumer only.
+  node_allocator m_alloc;                 //!< Stateless by default, so shared by all threads.
+
+  //! Allocates a node with an empty link and no element.
+  Node *create_node() {
+    Node *node = node_traits::allocate(m_alloc, 1);
+    ::new (static_cast<void *>(node)) Node;
+    return node;
+  }
+
+  //! Frees a node whose element, if any, was already destroyed.
+  void destroy_node(Node *node) {
+    node->~Node();
+    node_traits::deallocate(m_alloc, node, 1);
+  }
+};
+
+} // namespace sc
+#endif
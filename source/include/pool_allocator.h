@@ -0,0 +1,486 @@
+#ifndef _POOL_ALLOCATOR_H_
+#define _POOL_ALLOCATOR_H_
+
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <memory>    // std::allocator
+#include <mutex>     // std::mutex, std::lock_guard
+#include <new>       // operator new, std::align_val_t
+#include <type_traits>
+#include <utility>   // std::declval
+#include <vector>
+
+namespace sc {
+namespace detail {
+
+//! Number of blocks all the pools together have taken from the system.
+inline std::atomic<std::size_t> pool_blocks{0};
+
+/*!
+ *  \class slab_pool
+ *  \brief Fixed-size object pool that carves slots out of large blocks.
+ *
+ *  Every thread keeps a private free list of slots, so `allocate()` and
+ *  `deallocate()` are a couple of pointer moves and never take a lock.
+ *  When a thread runs out of slots it grabs a whole chain of free slots from
+ *  the shared reserve (or a brand new block); when it accumulates too many it
+ *  hands a chain back. That keeps producer/consumer patterns (allocate on one
+ *  thread, free on another) from growing a single cache forever. A thread that
+ *  exits gives its whole cache back to the reserve.
+ *
+ *  \note Blocks are never returned to the system: freed slots are recycled
+ *  for the lifetime of the program. The shared state is intentionally leaked
+ *  so that lists with static storage duration can still free their nodes
+ *  during program shutdown.
+ *
+ *  \tparam Size Size, in bytes, of the objects served by this pool.
+ *  \tparam Align Alignment of the objects served by this pool.
+ */
+template <std::size_t Size, std::size_t Align>
+class slab_pool {
+  //! A free slot reuses the object's storage to link to the next free slot.
+  union slot {
+    slot *next;
+    alignas(Align) unsigned char storage[Size];
+  };
+
+  static constexpr std::size_t block_bytes = 64 * 1024;
+  //! Number of slots in a block, which is also the size of the chains traded with the shared reserve.
+  static constexpr std::size_t chain_len =
+      block_bytes / sizeof(slot) > 32 ? block_bytes / sizeof(slot) : 32;
+  //! A thread cache larger than this gives one chain back to the shared reserve.
+  static constexpr std::size_t cache_limit = 2 * chain_len;
+
+  //! State shared by all threads, always accessed under `mtx`.
+  struct shared_state {
+    std::mutex mtx;
+    std::vector<slot *> chains; //!< Free chains, each with exactly `chain_len` slots.
+    std::vector<void *> blocks; //!< Every block ever allocated.
+    slot *spare{nullptr};       //!< Slots left by exited threads, fewer than `chain_len`.
+    std::size_t spare_count{0};
+  };
+
+  //! Per-thread free list. Trivially destructible, so it stays usable during shutdown.
+  struct local_cache {
+    slot *head;
+    std::size_t count;
+    std::size_t limit; //!< Above this many slots the cache gives some back; zero once the thread exits.
+    bool owned;        //!< Whether a `cache_owner` will empty the cache when the thread exits.
+  };
+
+  //! Empties the thread's cache into the reserve when the thread exits.
+  struct cache_owner {
+    ~cache_owner() {
+      local_cache &cache = thread_cache();
+      cache.limit = 0; // Slots freed from now on go straight back to the reserve.
+      give_back(cache);
+    }
+  };
+
+  static shared_state &shared() {
+    static shared_state *state = new shared_state;
+    return *state;
+  }
+
+  static local_cache &thread_cache() {
+    thread_local local_cache cache{nullptr, 0, cache_limit, false};
+    return cache;
+  }
+
+  static local_cache &local() {
+    local_cache &cache = thread_cache();
+    if (!cache.owned) {
+      cache.owned = true;
+      thread_local cache_owner owner;
+      static_cast<void>(owner);
+    }
+    return cache;
+  }
+
+  //! Fills an empty thread cache with a chain from the reserve or with a new block.
+  static void refill(local_cache &cache) {
+    shared_state &state = shared();
+    {
+      std::lock_guard<std::mutex> lock(state.mtx);
+      if (!state.chains.empty()) {
+        cache.head = state.chains.back();
+        cache.count = chain_len;
+        state.chains.pop_back();
+        return;
+      }
+    }
+
+    slot *block = static_cast<slot *>(
+        ::operator new(chain_len * sizeof(slot), std::align_val_t{alignof(slot)}));
+    {
+      std::lock_guard<std::mutex> lock(state.mtx);
+      state.blocks.push_back(block);
+    }
+    pool_blocks.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i{0}; i + 1 < chain_len; ++i) {
+      block[i].next = &block[i + 1];
+    }
+    block[chain_len - 1].next = nullptr;
+    cache.head = block;
+    cache.count = chain_len;
+  }
+
+  /*!
+   *  Moves every slot of `cache` to the reserve. Full chains are published
+   *  right away; the rest waits in `spare` until it adds up to a chain.
+   */
+  static void give_back(local_cache &cache) noexcept {
+    if (cache.head == nullptr) {
+      return;
+    }
+    slot *last = cache.head;
+    while (last->next != nullptr) {
+      last = last->next;
+    }
+    shared_state &state = shared();
+    try {
+      std::lock_guard<std::mutex> lock(state.mtx);
+      last->next = state.spare;
+      state.spare = cache.head;
+      state.spare_count += cache.count;
+      cache.head = nullptr;
+      cache.count = 0;
+      while (state.spare_count >= chain_len) {
+        slot *end = state.spare;
+        for (std::size_t i{1}; i < chain_len; ++i) {
+          end = end->next;
+        }
+        state.chains.push_back(state.spare);
+        state.spare = end->next;
+        end->next = nullptr;
+        state.spare_count -= chain_len;
+      }
+    } catch (...) {
+      // Whatever could not be published stays where it is, still usable.
+    }
+  }
+
+  //! Moves one chain from an overfull thread cache back to the reserve.
+  static void flush(local_cache &cache) noexcept {
+    if (cache.limit == 0) {
+      give_back(cache); // The thread is exiting: keep nothing.
+      return;
+    }
+    slot *first = cache.head;
+    slot *last = first;
+    for (std::size_t i{1}; i < chain_len; ++i) {
+      last = last->next;
+    }
+    // Cut the chain before publishing it: once in the reserve, another thread may take it.
+    slot *rest = last->next;
+    last->next = nullptr;
+    try {
+      std::lock_guard<std::mutex> lock(shared().mtx);
+      shared().chains.push_back(first);
+    } catch (...) {
+      last->next = rest; // Keep the slots in this thread; we will try again later.
+      return;
+    }
+    cache.head = rest;
+    cache.count -= chain_len;
+  }
+
+public:
+  //! Distance, in bytes, between two neighbouring slots of a block.
+  static constexpr std::size_t slot_size = sizeof(slot);
+
+  /*!
+   *  \class batch
+   *  \brief Storage being given back in whole chains instead of slot by slot.
+   *
+   *  Adding a pointer reuses its storage as a link, just like `deallocate()`
+   *  does, so the object must already be destroyed. Slots stay in the order
+   *  they were added, so a run freed front to back can be handed out again
+   *  as a run by `allocate_run()`. Every `chain_len` slots
+   *  the batch goes straight to the shared reserve under one lock, without
+   *  passing through (and overflowing) the thread cache. `release()` hands
+   *  over what is left.
+   */
+  class batch {
+  public:
+    void add(void *p) noexcept {
+      slot *s = static_cast<slot *>(p);
+      s->next = nullptr;
+      if (m_tail == nullptr) {
+        m_head = s;
+      } else {
+        m_tail->next = s;
+      }
+      m_tail = s;
+      if (++m_count == chain_len) {
+        publish();
+      }
+    }
+
+  private:
+    slot *m_head{nullptr};
+    slot *m_tail{nullptr};
+    std::size_t m_count{0};
+
+    void publish() noexcept {
+      try {
+        std::lock_guard<std::mutex> lock(shared().mtx);
+        shared().chains.push_back(m_head);
+      } catch (...) {
+        release(*this); // Keep the slots in this thread instead.
+        return;
+      }
+      *this = batch{};
+    }
+
+    friend class slab_pool;
+  };
+
+  /*!
+   *  Makes sure the calling thread can allocate `n` objects without going
+   *  back to the shared reserve or the system. Missing slots are taken from
+   *  the reserve first, then carved out of a single new block.
+   */
+  static void reserve(std::size_t n) {
+    local_cache &cache = local();
+    shared_state &state = shared();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    while (cache.count < n && !state.chains.empty()) {
+      slot *first = state.chains.back();
+      slot *last = first;
+      while (last->next != nullptr) {
+        last = last->next;
+      }
+      last->next = cache.head;
+      cache.head = first;
+      cache.count += chain_len;
+      state.chains.pop_back();
+    }
+    if (cache.count >= n) {
+      return;
+    }
+
+    std::size_t missing = n - cache.count;
+    std::size_t slots = (missing + chain_len - 1) / chain_len * chain_len;
+    state.blocks.reserve(state.blocks.size() + 1);
+    slot *block = static_cast<slot *>(
+        ::operator new(slots * sizeof(slot), std::align_val_t{alignof(slot)}));
+    state.blocks.push_back(block);
+    pool_blocks.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i{0}; i + 1 < slots; ++i) {
+      block[i].next = &block[i + 1];
+    }
+    block[slots - 1].next = cache.head;
+    cache.head = block;
+    cache.count += slots;
+  }
+
+  /*!
+   *  Returns `n` slots that sit back to back, in address order, which are
+   *  given back one at a time with `deallocate()`.
+   *
+   *  The front of the thread cache is used when it holds such a run, which
+   *  is the case after a run has been freed front to back. Otherwise, if the
+   *  cache and the shared reserve have `n` free slots between them, returns
+   *  null: the caller should take them one at a time, so that freed memory
+   *  is reused before the pool grows. Only then is a new block carved, with
+   *  the rest of it (less than a chain) going to the thread cache.
+   */
+  static void *allocate_run(std::size_t n) {
+    local_cache &cache = local();
+    if (cache.count >= n) {
+      slot *last = cache.head;
+      std::size_t i{1};
+      for (; i < n && last->next == last + 1; ++i) {
+        last = last->next;
+      }
+      if (i == n) {
+        slot *first = cache.head;
+        cache.head = last->next;
+        cache.count -= n;
+        return first;
+      }
+    }
+
+    shared_state &state = shared();
+    std::lock_guard<std::mutex> lock(state.mtx);
+    if (cache.count + state.chains.size() * chain_len >= n) {
+      return nullptr;
+    }
+    std::size_t slots = (n + chain_len - 1) / chain_len * chain_len;
+    state.blocks.reserve(state.blocks.size() + 1);
+    slot *block = static_cast<slot *>(
+        ::operator new(slots * sizeof(slot), std::align_val_t{alignof(slot)}));
+    state.blocks.push_back(block);
+    pool_blocks.fetch_add(1, std::memory_order_relaxed);
+    if (slots > n) {
+      for (std::size_t i{n}; i + 1 < slots; ++i) {
+        block[i].next = &block[i + 1];
+      }
+      block[slots - 1].next = cache.head;
+      cache.head = &block[n];
+      cache.count += slots - n;
+    }
+    return block;
+  }
+
+  //! Returns uninitialized storage for one object.
+  static void *allocate() {
+    local_cache &cache = local();
+    if (cache.head == nullptr) {
+      refill(cache);
+    }
+    slot *s = cache.head;
+    cache.head = s->next;
+    --cache.count;
+    return s;
+  }
+
+  //! Gives back everything in `b` at once; `b` is left empty.
+  static void release(batch &b) noexcept {
+    if (b.m_head == nullptr) {
+      return;
+    }
+    local_cache &cache = local();
+    b.m_tail->next = cache.head;
+    cache.head = b.m_head;
+    cache.count += b.m_count;
+    if (cache.count > cache.limit) {
+      flush(cache);
+    }
+    b = batch{};
+  }
+
+  //! Gives back storage obtained from `allocate()`, possibly from another thread.
+  static void deallocate(void *p) noexcept {
+    local_cache &cache = local();
+    slot *s = static_cast<slot *>(p);
+    s->next = cache.head;
+    cache.head = s;
+    if (++cache.count > cache.limit) {
+      flush(cache);
+    }
+  }
+};
+
+} // namespace detail
+
+/*!
+ *  \class pool_allocator
+ *  \brief Stateless allocator that serves single objects from a `slab_pool`.
+ *
+ *  Requests for one object (which is what node-based containers do) never
+ *  touch the global heap on the hot path. Requests for arrays fall back to
+ *  `std::allocator`. All instances compare equal, so nodes may be freely
+ *  moved between containers with `splice()` or `merge()`.
+ *
+ *  \tparam T The type of the objects being allocated.
+ */
+template <typename T>
+class pool_allocator {
+  using pool = detail::slab_pool<sizeof(T), alignof(T)>;
+
+public:
+  using value_type = T;
+
+  pool_allocator() noexcept = default;
+
+  //! Converting constructor, required by `std::allocator_traits::rebind_alloc`.
+  template <typename U>
+  pool_allocator(const pool_allocator<U> &) noexcept { /* empty */ }
+
+  /*!
+   *  Allocates uninitialized storage for `n` objects.
+   *  \param n The number of objects.
+   *  \return Pointer to the storage.
+   */
+  T *allocate(std::size_t n) {
+    if (n == 1) {
+      return static_cast<T *>(pool::allocate());
+    }
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  /*!
+   *  Prepares the pool so that the calling thread can allocate `n` single
+   *  objects without refilling, e.g. before building a large list.
+   */
+  void reserve(std::size_t n) { pool::reserve(n); }
+
+  /*!
+   *  Allocates `n` objects back to back, like an array, except that each one
+   *  is released on its own with `deallocate(p, 1)`. Lists use it to build
+   *  long runs of nodes that are walked in address order.
+   *  \return The first object, or null if the pool would rather hand out
+   *  free objects it already has with `allocate(1)`, one at a time.
+   */
+  T *allocate_run(std::size_t n) {
+    static_assert(pool::slot_size == sizeof(T), "the pool cannot pack objects of this type back to back");
+    return static_cast<T *>(pool::allocate_run(n));
+  }
+
+  //! Storage collected to be released together, see `deallocate(release_batch &)`.
+  using release_batch = typename pool::batch;
+
+  /*!
+   *  Releases storage obtained from `allocate()`.
+   *  \param p Pointer returned by `allocate(n)`.
+   *  \param n The same count that was passed to `allocate()`.
+   */
+  void deallocate(T *p, std::size_t n) noexcept {
+    if (n == 1) {
+      pool::deallocate(p);
+    } else {
+      std::allocator<T>{}.deallocate(p, n);
+    }
+  }
+
+  /*!
+   *  Releases every single object collected in `batch` with one visit to the
+   *  thread cache, instead of one `deallocate(p, 1)` each.
+   */
+  void deallocate(release_batch &batch) noexcept { pool::release(batch); }
+
+  //! Number of blocks that all pools together have taken from the system so far.
+  static std::size_t system_blocks() noexcept {
+    return detail::pool_blocks.load(std::memory_order_relaxed);
+  }
+};
+
+//! All pool allocators share the same pools, so they are always interchangeable.
+template <typename T, typename U>
+inline bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) {
+  return true;
+}
+
+template <typename T, typename U>
+inline bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) {
+  return false;
+}
+
+namespace detail {
+//! Whether an allocator can hand out runs of single objects with `allocate_run(n)`.
+template <typename A, typename = void>
+struct has_allocate_run : std::false_type {};
+
+template <typename A>
+struct has_allocate_run<A, std::void_t<decltype(std::declval<A &>().allocate_run(std::size_t{}))>>
+    : std::true_type {};
+
+//! Stands in for the `release_batch` of allocators that have none.
+struct no_release_batch {};
+
+//! The `release_batch` of an allocator, through which it frees many single objects at once.
+template <typename A, typename = void>
+struct release_batch_of {
+  using type = no_release_batch;
+};
+
+template <typename A>
+struct release_batch_of<A, std::void_t<typename A::release_batch>> {
+  using type = typename A::release_batch;
+};
+} // namespace detail
+
+} // namespace sc
+#endif
@@ -0,0 +1,290 @@
+#ifndef _SIMD_H_
+#define _SIMD_H_
+
+#include <cstddef>     // std::size_t
+#include <cstdint>
+#include <type_traits>
+
+// Define SC_SIMD_DISABLE to force the scalar kernels, e.g. to compare results.
+#if !defined(SC_SIMD_DISABLE) && defined(__AVX2__)
+#define SC_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(SC_SIMD_DISABLE) && defined(__SSE2__)
+#define SC_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace sc {
+/*!
+ *  Kernels over contiguous arrays, used by the chunked containers for their scans.
+ *
+ *  32- and 64-bit integers are processed with AVX2 when the compiler targets it
+ *  (e.g. `-mavx2` or `-march=native`) and with SSE2 otherwise on x86-64.
+ *  Every other type, and every other target, uses a plain loop with `==`, `<` and
+ *  `+`, so the results never depend on the instruction set.
+ */
+namespace simd {
+namespace detail {
+
+//! Whether the vector kernels handle `T`.
+template <typename T>
+constexpr bool vectorizable = std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                              (sizeof(T) == 4 || sizeof(T) == 8);
+
+//! Sums wrap around like unsigned arithmetic, as the vector adds do.
+template <typename T>
+T wrapping_add(T a, T b) {
+  if constexpr (std::is_integral<T>::value && !std::is_same<T, bool>::value) {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<T>(static_cast<U>(static_cast<U>(a) + static_cast<U>(b)));
+  } else {
+    return a + b;
+  }
+}
+
+#if defined(SC_SIMD_AVX2) || defined(SC_SIMD_SSE2)
+/*!
+ *  \struct isa
+ *  \brief The handful of integer vector operations the kernels need, for the selected instruction set.
+ */
+struct isa {
+#if defined(SC_SIMD_AVX2)
+  using reg = __m256i;
+  static constexpr std::size_t bytes = 32;
+  static reg load(const void *p) { return _mm256_loadu_si256(static_cast<const reg *>(p)); }
+  static void store(void *p, reg v) { _mm256_storeu_si256(static_cast<reg *>(p), v); }
+  static reg splat(std::int32_t v) { return _mm256_set1_epi32(v); }
+  static reg splat(std::int64_t v) { return _mm256_set1_epi64x(v); }
+  static reg eq32(reg a, reg b) { return _mm256_cmpeq_epi32(a, b); }
+  static reg eq64(reg a, reg b) { return _mm256_cmpeq_epi64(a, b); }
+  static reg gt32(reg a, reg b) { return _mm256_cmpgt_epi32(a, b); }
+  static reg gt64(reg a, reg b) { return _mm256_cmpgt_epi64(a, b); }
+  static constexpr bool has_gt64 = true;
+  static reg add32(reg a, reg b) { return _mm256_add_epi32(a, b); }
+  static reg add64(reg a, reg b) { return _mm256_add_epi64(a, b); }
+  static reg bit_xor(reg a, reg b) { return _mm256_xor_si256(a, b); }
+  static reg select(reg mask, reg a, reg b) { return _mm256_blendv_epi8(b, a, mask); }
+  static reg zero() { return _mm256_setzero_si256(); }
+  //! One bit per byte of the comparison result.
+  static std::uint32_t mask(reg v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); }
+#else
+  using reg = __m128i;
+  static constexpr std::size_t bytes = 16;
+  static reg load(const void *p) { return _mm_loadu_si128(static_cast<const reg *>(p)); }
+  static void store(void *p, reg v) { _mm_storeu_si128(static_cast<reg *>(p), v); }
+  static reg splat(std::int32_t v) { return _mm_set1_epi32(v); }
+  static reg splat(std::int64_t v) { return _mm_set1_epi64x(v); }
+  static reg eq32(reg a, reg b) { return _mm_cmpeq_epi32(a, b); }
+  //! SSE2 has no 64-bit compare: both 32-bit halves must match.
+  static reg eq64(reg a, reg b) {
+    reg halves = _mm_cmpeq_epi32(a, b);
+    return _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+  }
+  static reg gt32(reg a, reg b) { return _mm_cmpgt_epi32(a, b); }
+  static reg gt64(reg, reg b) { return b; } // Never called: see has_gt64.
+  static constexpr bool has_gt64 = false;
+  static reg add32(reg a, reg b) { return _mm_add_epi32(a, b); }
+  static reg add64(reg a, reg b) { return _mm_add_epi64(a, b); }
+  static reg bit_xor(reg a, reg b) { return _mm_xor_si128(a, b); }
+  static reg select(reg mask, reg a, reg b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+  }
+  static reg zero() { return _mm_setzero_si128(); }
+  static std::uint32_t mask(reg v) { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+#endif
+
+  template <typename T> static reg splat_of(T v) {
+    if constexpr (sizeof(T) == 4) {
+      return splat(static_cast<std::int32_t>(v));
+    } else {
+      return splat(static_cast<std::int64_t>(v));
+    }
+  }
+  template <typename T> static reg eq(reg a, reg b) {
+    if constexpr (sizeof(T) == 4) { return eq32(a, b); } else { return eq64(a, b); }
+  }
+  template <typename T> static reg add(reg a, reg b) {
+    if constexpr (sizeof(T) == 4) { return add32(a, b); } else { return add64(a, b); }
+  }
+  //! Lane-wise `a > b` for T; unsigned lanes are compared by flipping their sign bit first.
+  template <typename T> static reg gt(reg a, reg b) {
+    if constexpr (std::is_unsigned<T>::value) {
+      reg bias = splat_of<T>(static_cast<T>(T{1} << (sizeof(T) * 8 - 1)));
+      a = bit_xor(a, bias);
+      b = bit_xor(b, bias);
+    }
+    if constexpr (sizeof(T) == 4) { return gt32(a, b); } else { return gt64(a, b); }
+  }
+  //! Whether lane-wise ordering is available for T.
+  template <typename T> static constexpr bool has_gt() { return sizeof(T) == 4 || has_gt64; }
+};
+
+//! Index of the lowest set lane in a byte mask.
+inline std::size_t first_lane(std::uint32_t mask, std::size_t lane_bytes) {
+  return static_cast<std::size_t>(__builtin_ctz(mask)) / lane_bytes;
+}
+#endif
+
+} // namespace detail
+
+/*!
+ *  Finds the first element equal to `value`.
+ *  \return Its index, or `n` if there is none.
+ */
+template <typename T>
+std::size_t find(const T *p, std::size_t n, const T &value) {
+  std::size_t i{0};
+#if defined(SC_SIMD_AVX2) || defined(SC_SIMD_SSE2)
+  if constexpr (detail::vectorizable<T>) {
+    using isa = detail::isa;
+    constexpr std::size_t lanes = isa::bytes / sizeof(T);
+    const typename isa::reg needle = isa::splat_of(value);
+    for (; i + lanes <= n; i += lanes) {
+      std::uint32_t hits = isa::mask(isa::eq<T>(isa::load(p + i), needle));
+      if (hits != 0) {
+        return i + detail::first_lane(hits, sizeof(T));
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (p[i] == value) {
+      return i;
+    }
+  }
+  return n;
+}
+
+//! Returns how many elements are equal to `value`.
+template <typename T>
+std::size_t count(const T *p, std::size_t n, const T &value) {
+  std::size_t i{0};
+  std::size_t total{0};
+#if defined(SC_SIMD_AVX2) || defined(SC_SIMD_SSE2)
+  if constexpr (detail::vectorizable<T>) {
+    using isa = detail::isa;
+    constexpr std::size_t lanes = isa::bytes / sizeof(T);
+    const typename isa::reg needle = isa::splat_of(value);
+    for (; i + lanes <= n; i += lanes) {
+      total += static_cast<std::size_t>(
+                   __builtin_popcount(isa::mask(isa::eq<T>(isa::load(p + i), needle)))) / sizeof(T);
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (p[i] == value) {
+      ++total;
+    }
+  }
+  return total;
+}
+
+//! Returns true if the `n` elements of `a` and `b` are pairwise equal.
+template <typename T>
+bool equal(const T *a, const T *b, std::size_t n) {
+  std::size_t i{0};
+#if defined(SC_SIMD_AVX2) || defined(SC_SIMD_SSE2)
+  if constexpr (detail::vectorizable<T>) {
+    using isa = detail::isa;
+    constexpr std::size_t lanes = isa::bytes / sizeof(T);
+    constexpr std::uint32_t all = isa::bytes == 32 ? 0xffffffffu : 0xffffu;
+    for (; i + lanes <= n; i += lanes) {
+      if (isa::mask(isa::eq<T>(isa::load(a + i), isa::load(b + i))) != all) {
+        return false;
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (!(a[i] == b[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+ *  Finds the smallest (`Max == false`) or largest (`Max == true`) of `n > 0` elements.
+ *  Among equivalent elements, the first one wins.
+ *  \return Its index, always below `n`.
+ */
+template <bool Max, typename T>
+std::size_t extreme(const T *p, std::size_t n) {
+  std::size_t i{0};
+  std::size_t best{0};
+#if defined(SC_SIMD_AVX2) || defined(SC_SIMD_SSE2)
+  if constexpr (detail::vectorizable<T>) {
+    using isa = detail::isa;
+    using index_t = std::conditional_t<sizeof(T) == 4, std::int32_t, std::int64_t>;
+    constexpr std::size_t lanes = isa::bytes / sizeof(T);
+    if constexpr (isa::has_gt<T>()) {
+      if (n >= lanes) {
+        // Each lane keeps its best value and where it was seen.
+        index_t start[lanes];
+        for (std::size_t k{0}; k < lanes; ++k) { start[k] = static_cast<index_t>(k); }
+        typename isa::reg acc = isa::load(p);
+        typename isa::reg at = isa::load(start);
+        typename isa::reg where = at;
+        const typename isa::reg step = isa::splat(static_cast<index_t>(lanes));
+        for (i = lanes; i + lanes <= n; i += lanes) {
+          typename isa::reg v = isa::load(p + i);
+          at = isa::add<T>(at, step);
+          // Replace a lane only when strictly better, so it keeps its first position.
+          typename isa::reg better = Max ? isa::gt<T>(v, acc) : isa::gt<T>(acc, v);
+          acc = isa::select(better, v, acc);
+          where = isa::select(better, at, where);
+        }
+        T lane[lanes];
+        index_t pos[lanes];
+        isa::store(lane, acc);
+        isa::store(pos, where);
+        std::size_t k_best{0};
+        for (std::size_t k{1}; k < lanes; ++k) {
+          bool better = Max ? lane[k_best] < lane[k] : lane[k] < lane[k_best];
+          if (better || (lane[k] == lane[k_best] && pos[k] < pos[k_best])) {
+            k_best = k;
+          }
+        }
+        best = static_cast<std::size_t>(pos[k_best]);
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    if (Max ? p[best] < p[i] : p[i] < p[best]) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+//! Returns `init` plus the sum of the `n` elements; integer sums wrap around.
+template <typename T>
+T accumulate(const T *p, std::size_t n, T init) {
+  std::size_t i{0};
+#if defined(SC_SIMD_AVX2) || defined(SC_SIMD_SSE2)
+  if constexpr (detail::vectorizable<T>) {
+    using isa = detail::isa;
+    constexpr std::size_t lanes = isa::bytes / sizeof(T);
+    if (n >= lanes) {
+      typename isa::reg acc = isa::zero();
+      for (; i + lanes <= n; i += lanes) {
+        acc = isa::add<T>(acc, isa::load(p + i));
+      }
+      T lane[lanes];
+      isa::store(lane, acc);
+      for (std::size_t k{0}; k < lanes; ++k) {
+        init = detail::wrapping_add(init, lane[k]);
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    init = detail::wrapping_add(init, p[i]);
+  }
+  return init;
+}
+
+} // namespace simd
+} // namespace sc
+#endif
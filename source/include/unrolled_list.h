@@ -0,0 +1,1112 @@
+#ifndef _UNROLLED_LIST_H_
+#define _UNROLLED_LIST_H_
+
+#include <algorithm>        // std::min
+#include <cassert>          // assert()
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <initializer_list>
+#include <iterator>         // bidirectional_iterator_tag
+#include <memory>           // std::allocator_traits
+#include <new>              // placement new, std::launder
+#include <stdexcept>        // std::out_of_range
+#include <type_traits>
+#include <utility>          // std::move, std::swap
+
+#include "pool_allocator.h"
+#include "simd.h"
+
+namespace sc {
+namespace detail {
+//! Default number of elements per unrolled node: about 256 bytes of payload, at least 4 elements.
+template <typename T>
+constexpr std::size_t unrolled_capacity() {
+  return sizeof(T) * 4 >= 256 ? 4 : 256 / sizeof(T);
+}
+} // namespace detail
+
+/*!
+ *  \class unrolled_list
+ *  \brief Doubly-linked list whose nodes hold a small array of elements.
+ *
+ *  Offers the same iterator and modifier API as `sc::list`, but stores up to
+ *  `N` elements contiguously in each node. Scans touch far fewer cache lines
+ *  and the link overhead is paid once per node instead of once per element.
+ *  A full node is split in two on insertion; a node that drops below half
+ *  capacity absorbs its successor on erasure when they fit together.
+ *
+ *  \note Unlike `sc::list`, any insertion or erasure may invalidate iterators
+ *  to the elements of the node(s) involved, since elements shift inside a node.
+ *  Splicing from another list and merging move elements rather than only
+ *  relinking nodes wherever a node has to be shared. Positional access
+ *  (`at`, `nth`), `remove`/`remove_if`, the partitions, `save`/`load`, the
+ *  statistics policies and the parallel sort of `sc::list` are not offered.
+ *
+ *  \tparam T The type of data stored in the list.
+ *  \tparam N The maximum number of elements per node.
+ *  \tparam Alloc The allocator used for the nodes (rebound to the node type).
+ */
+template <typename T, std::size_t N = detail::unrolled_capacity<T>(),
+          typename Alloc = sc::pool_allocator<T>>
+class unrolled_list {
+  static_assert(N >= 2, "an unrolled node must hold at least two elements");
+
+private:
+  //! Links shared by data nodes and the (data-free) sentinels.
+  struct node_base {
+    node_base *next;   //!< Pointer to the next node.
+    node_base *prev;   //!< Pointer to the previous node.
+    std::size_t count; //!< Number of live elements; always zero for the sentinels.
+  };
+
+  //! A data node: links plus raw storage for up to `N` elements.
+  struct Node : node_base {
+    alignas(T) unsigned char storage[N * sizeof(T)];
+
+    //! Address of slot `i`, where an element may be constructed.
+    void *raw(std::size_t i) { return storage + i * sizeof(T); }
+    //! The live element at slot `i`.
+    T *at(std::size_t i) { return std::launder(reinterpret_cast<T *>(raw(i))); }
+  };
+
+  static Node *as_node(node_base *n) { return static_cast<Node *>(n); }
+
+  /*!
+   *  \class iterator_impl
+   *  \brief Bidirectional iterator over an unrolled list: a node plus a slot index.
+   *  \tparam Const Whether this iterator gives read-only access.
+   */
+  template <bool Const>
+  class iterator_impl {
+  public:
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+  private:
+    node_base *m_node;   //!< The node holding the element.
+    std::size_t m_idx;   //!< The slot of the element inside the node.
+
+  public:
+    iterator_impl(node_base *node = nullptr, std::size_t idx = 0) : m_node{node}, m_idx{idx} { }
+
+    //! A mutable iterator converts to a const one.
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    iterator_impl(const iterator_impl<false> &other) : m_node{other.m_node}, m_idx{other.m_idx} { }
+
+    reference operator*() const { return *as_node(m_node)->at(m_idx); }
+    pointer operator->() const { return as_node(m_node)->at(m_idx); }
+
+    iterator_impl &operator++() {
+      assert(m_node->count > 0);
+      if (++m_idx == m_node->count) {
+        m_node = m_node->next;
+        m_idx = 0;
+      }
+      return *this;
+    }
+
+    iterator_impl operator++(int) {
+      iterator_impl temp{*this};
+      ++*this;
+      return temp;
+    }
+
+    iterator_impl &operator--() {
+      if (m_idx == 0) {
+        m_node = m_node->prev;
+        assert(m_node->count > 0);
+        m_idx = m_node->count;
+      }
+      --m_idx;
+      return *this;
+    }
+
+    iterator_impl operator--(int) {
+      iterator_impl temp{*this};
+      --*this;
+      return temp;
+    }
+
+    /*!
+     *  Advances the iterator by a given number of steps, skipping whole nodes at a time.
+     *  \param step The number of steps to advance.
+     *  \return Reference to the updated iterator.
+     */
+    iterator_impl &operator+=(difference_type step) {
+      if (step < 0) { return *this -= -step; }
+      auto left = static_cast<std::size_t>(step);
+      while (left > 0 && left >= m_node->count - m_idx) {
+        left -= m_node->count - m_idx;
+        m_node = m_node->next;
+        m_idx = 0;
+      }
+      m_idx += left;
+      return *this;
+    }
+
+    /*!
+     *  Moves the iterator back by a given number of steps, skipping whole nodes at a time.
+     *  \param step The number of steps to move back.
+     *  \return Reference to the updated iterator.
+     */
+    iterator_impl &operator-=(difference_type step) {
+      if (step < 0) { return *this += -step; }
+      auto left = static_cast<std::size_t>(step);
+      while (left > m_idx) {
+        left -= m_idx + 1;
+        m_node = m_node->prev;
+        m_idx = m_node->count - 1;
+      }
+      m_idx -= left;
+      return *this;
+    }
+
+    bool operator==(const iterator_impl &rhs) const {
+      return m_node == rhs.m_node && m_idx == rhs.m_idx;
+    }
+    bool operator!=(const iterator_impl &rhs) const { return !(*this == rhs); }
+
+    friend class unrolled_list;
+    friend class iterator_impl<!Const>;
+  };
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Alloc;
+  using iterator = iterator_impl<false>;      //!< Mutable iterator.
+  using const_iterator = iterator_impl<true>; //!< Read-only iterator.
+
+private:
+  using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  node_base m_head;       //!< Sentinel before the first node.
+  node_base m_tail;       //!< Sentinel after the last node.
+  size_type m_len;        //!< Number of elements.
+  node_allocator m_alloc; //!< Where the nodes come from.
+
+  //! Gets raw memory for an empty node. Elements are built in place later.
+  Node *create_node() {
+    Node *node = node_traits::allocate(m_alloc, 1);
+    ::new (static_cast<void *>(node)) Node;
+    node->count = 0;
+    return node;
+  }
+
+  //! Destroys the elements of a node and gives its memory back.
+  void destroy_node(Node *node) {
+    for (size_type i{0}; i < node->count; ++i) {
+      node->at(i)->~T();
+    }
+    node->~Node();
+    node_traits::deallocate(m_alloc, node, 1);
+  }
+
+  //! Resets the sentinels to the empty list configuration.
+  void init_sentinels() {
+    m_head.prev = nullptr;
+    m_head.next = &m_tail;
+    m_head.count = 0;
+    m_tail.prev = &m_head;
+    m_tail.next = nullptr;
+    m_tail.count = 0;
+  }
+
+  //! Links `node` right before `pos`.
+  static void link_before(node_base *pos, node_base *node) {
+    node->prev = pos->prev;
+    node->next = pos;
+    pos->prev->next = node;
+    pos->prev = node;
+  }
+
+  //! Unlinks `node` from its neighbours.
+  static void unlink(node_base *node) {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+  }
+
+  //! Hangs the chain [first, last] between the sentinels, or empties the list if `first` is null.
+  void adopt_chain(node_base *first, node_base *last) {
+    init_sentinels();
+    if (first != nullptr) {
+      m_head.next = first;
+      first->prev = &m_head;
+      m_tail.prev = last;
+      last->next = &m_tail;
+    }
+  }
+
+  //! Builds `value` at slot `idx` of a node that still has room, shifting the slots after it.
+  void insert_in_node(Node *node, size_type idx, T value) {
+    assert(node->count < N);
+    if (idx == node->count) {
+      ::new (node->raw(idx)) T(std::move(value));
+    } else {
+      ::new (node->raw(node->count)) T(std::move(*node->at(node->count - 1)));
+      for (size_type i{node->count - 1}; i > idx; --i) {
+        *node->at(i) = std::move(*node->at(i - 1));
+      }
+      *node->at(idx) = std::move(value);
+    }
+    ++node->count;
+  }
+
+  //! Moves the elements of `node` from slot `from` on into a new node linked right after it.
+  Node *split(Node *node, size_type from) {
+    Node *right = create_node();
+    try {
+      for (size_type i{from}; i < node->count; ++i) {
+        ::new (right->raw(right->count)) T(std::move_if_noexcept(*node->at(i)));
+        ++right->count;
+      }
+    } catch (...) {
+      destroy_node(right);
+      throw;
+    }
+    for (size_type i{from}; i < node->count; ++i) {
+      node->at(i)->~T();
+    }
+    node->count = from;
+    link_before(node->next, right);
+    return right;
+  }
+
+  //! Builds a new element at the front of the list from `args`.
+  template <typename... Args>
+  void construct_front(Args &&...args) {
+    node_base *first = m_head.next;
+    if (first == &m_tail || first->count == N) {
+      first = create_node();
+      link_before(m_head.next, first);
+      try {
+        ::new (as_node(first)->raw(0)) T(std::forward<Args>(args)...);
+      } catch (...) {
+        unlink(first);
+        destroy_node(as_node(first));
+        throw;
+      }
+      first->count = 1;
+    } else {
+      insert_in_node(as_node(first), 0, T(std::forward<Args>(args)...));
+    }
+    ++m_len;
+  }
+
+  //! Builds a new element at the end of the list from `args`.
+  template <typename... Args>
+  void construct_back(Args &&...args) {
+    node_base *last = m_tail.prev;
+    if (last == &m_head || last->count == N) {
+      last = create_node();
+      link_before(&m_tail, last);
+      try {
+        ::new (as_node(last)->raw(0)) T(std::forward<Args>(args)...);
+      } catch (...) {
+        unlink(last);
+        destroy_node(as_node(last));
+        throw;
+      }
+      last->count = 1;
+    } else {
+      ::new (as_node(last)->raw(last->count)) T(std::forward<Args>(args)...);
+      ++last->count;
+    }
+    ++m_len;
+  }
+
+  /*!
+   *  Moves the elements of the next node into `node` if it is under half full and both fit.
+   *  \return True if the nodes were merged.
+   */
+  bool try_merge(node_base *base) {
+    node_base *next = base->next;
+    if (base == &m_head || next == &m_tail) { return false; }
+    if (base->count + next->count > N) { return false; }
+    if (base->count >= N / 2 && next->count >= N / 2) { return false; }
+
+    Node *node = as_node(base);
+    Node *victim = as_node(next);
+    for (size_type i{0}; i < victim->count; ++i) {
+      ::new (node->raw(node->count)) T(std::move(*victim->at(i)));
+      ++node->count;
+    }
+    unlink(victim);
+    destroy_node(victim);
+    return true;
+  }
+
+  //! Links the chain [first, last] of `count` elements before `pos`, splitting the node that holds `pos`.
+  void hang_before(const_iterator pos, node_base *first, node_base *last, size_type count) {
+    node_base *before = pos.m_node;
+    if (pos.m_idx != 0) {
+      before = split(as_node(before), pos.m_idx);
+    }
+    first->prev = before->prev;
+    before->prev->next = first;
+    last->next = before;
+    before->prev = last;
+    m_len += count;
+    // Keep the nodes dense where the chains meet.
+    try_merge(last);
+    try_merge(first->prev);
+  }
+
+  //! The position of `it`, found one node at a time.
+  size_type index_of(const_iterator it) const {
+    size_type index{0};
+    for (const node_base *node = m_head.next; node != it.m_node; node = node->next) {
+      index += node->count;
+    }
+    return index + it.m_idx;
+  }
+
+  static iterator mutable_of(const_iterator it) { return iterator{it.m_node, it.m_idx}; }
+
+  /*!
+   *  Merges the sorted runs [first, middle) and [middle, middle + len2) in
+   *  place, stably: the longer run is cut in half, the matching cut of the
+   *  other run is found by binary search, and the two middle parts are
+   *  swapped with a rotation. Never allocates.
+   */
+  template <typename Compare>
+  static void merge_in_place(iterator first, iterator middle, size_type len1, size_type len2, Compare &comp) {
+    if (len1 == 0 || len2 == 0) { return; }
+    if (len1 + len2 == 2) {
+      if (comp(*middle, *first)) { std::iter_swap(first, middle); }
+      return;
+    }
+    if (!comp(*middle, *std::prev(middle))) { return; } // Already in order.
+    iterator first_cut{first};
+    iterator second_cut{middle};
+    size_type len11{0};
+    size_type len22{0};
+    if (len1 > len2) {
+      len11 = len1 / 2;
+      first_cut += static_cast<difference_type>(len11);
+      // The first element of the second run that does not go before *first_cut.
+      for (size_type left{len2}; left > 0;) {
+        size_type half{left / 2};
+        iterator probe{second_cut};
+        probe += static_cast<difference_type>(half);
+        if (comp(*probe, *first_cut)) {
+          second_cut = ++probe;
+          len22 += half + 1;
+          left -= half + 1;
+        } else {
+          left = half;
+        }
+      }
+    } else {
+      len22 = len2 / 2;
+      second_cut += static_cast<difference_type>(len22);
+      // The first element of the first run that goes after *second_cut.
+      for (size_type left{len1}; left > 0;) {
+        size_type half{left / 2};
+        iterator probe{first_cut};
+        probe += static_cast<difference_type>(half);
+        if (!comp(*second_cut, *probe)) {
+          first_cut = ++probe;
+          len11 += half + 1;
+          left -= half + 1;
+        } else {
+          left = half;
+        }
+      }
+    }
+    iterator new_middle = std::rotate(first_cut, middle, second_cut);
+    merge_in_place(first, first_cut, len11, len22, comp);
+    merge_in_place(new_middle, second_cut, len1 - len11, len2 - len22, comp);
+  }
+
+public:
+  //=== [I] Special members
+  //! \brief Default constructor. Constructs an empty list without allocating.
+  unrolled_list() : m_len{0} { init_sentinels(); }
+
+  /*!
+   *  Constructs a list with the specified number of value-initialized elements.
+   *  \param count The number of elements to initialize the list with.
+   */
+  explicit unrolled_list(size_type count) : unrolled_list() {
+    for (size_type i{0}; i < count; ++i) {
+      push_back(T());
+    }
+  }
+
+  /*!
+   *  Constructs a list with elements from the range [first, last).
+   *  \param first The beginning of the range.
+   *  \param last The end of the range.
+   */
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+  unrolled_list(InputIt first, InputIt last) : unrolled_list() {
+    for (; first != last; ++first) {
+      push_back(*first);
+    }
+  }
+
+  /*!
+   *  Copy constructor.
+   *  \param clone_ The list to be copied.
+   */
+  unrolled_list(const unrolled_list &clone_)
+      : m_len{0}, m_alloc{node_traits::select_on_container_copy_construction(clone_.m_alloc)} {
+    init_sentinels();
+    try {
+      for (const auto &e : clone_) {
+        push_back(e);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  /*!
+   *  Move constructor. Takes over the nodes of another list without moving any element.
+   *  \param other The list to move from; it is left empty.
+   */
+  unrolled_list(unrolled_list &&other) noexcept : m_len{other.m_len}, m_alloc{std::move(other.m_alloc)} {
+    adopt_chain(other.empty() ? nullptr : other.m_head.next, other.m_tail.prev);
+    other.init_sentinels();
+    other.m_len = 0;
+  }
+
+  /*!
+   *  Constructs a list with elements from an initializer list.
+   *  \param ilist_ The initializer list to initialize the list with.
+   */
+  unrolled_list(std::initializer_list<T> ilist_) : unrolled_list(ilist_.begin(), ilist_.end()) { }
+
+  //! Destructor. Frees the memory occupied by the list.
+  ~unrolled_list() { clear(); }
+
+  /*!
+   *  Swaps the contents of two lists.
+   *  \param other The other list to swap with.
+   */
+  void swap(unrolled_list &other) noexcept {
+    node_base *first = empty() ? nullptr : m_head.next;
+    node_base *last = m_tail.prev;
+    node_base *ofirst = other.empty() ? nullptr : other.m_head.next;
+    node_base *olast = other.m_tail.prev;
+    adopt_chain(ofirst, olast);
+    other.adopt_chain(first, last);
+    std::swap(m_len, other.m_len);
+    std::swap(m_alloc, other.m_alloc);
+  }
+
+  /*!
+   *  Assignment operator.
+   *  \param rhs The list to copy from.
+   *  \return Reference to the updated list.
+   */
+  unrolled_list &operator=(const unrolled_list &rhs) {
+    if (this != &rhs) {
+      unrolled_list temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  /*!
+   *  Move assignment operator. Releases the current elements and takes over the nodes of `rhs`.
+   *  \param rhs The list to move from; it is left empty.
+   *  \return Reference to the updated list.
+   */
+  unrolled_list &operator=(unrolled_list &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  /*!
+   *  Replaces the contents of the list with the elements from an initializer list.
+   *  \param ilist_ The initializer list to copy from.
+   *  \return Reference to the updated list.
+   */
+  unrolled_list &operator=(std::initializer_list<T> ilist_) {
+    unrolled_list temp(ilist_);
+    swap(temp);
+    return *this;
+  }
+
+  //=== [II] ITERATORS
+  iterator begin() { return iterator{m_head.next, 0}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator cbegin() const { return const_iterator{m_head.next, 0}; }
+  iterator end() { return iterator{&m_tail, 0}; }
+  const_iterator end() const { return cend(); }
+  const_iterator cend() const { return const_iterator{const_cast<node_base *>(&m_tail), 0}; }
+
+  //=== [III] Capacity/Status
+  [[nodiscard]] bool empty() const { return m_len == 0; }
+  [[nodiscard]] size_type size() const { return m_len; }
+
+  //! \brief Returns a copy of the allocator associated with the list.
+  allocator_type get_allocator() const { return allocator_type(m_alloc); }
+
+  //=== [IV] Modifiers
+  //! Removes all elements from the list.
+  void clear() {
+    node_base *runner = m_head.next;
+    while (runner != &m_tail) {
+      node_base *next = runner->next;
+      destroy_node(as_node(runner));
+      runner = next;
+    }
+    init_sentinels();
+    m_len = 0;
+  }
+
+  /*!
+   *  Returns the first element in the list.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &front() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *begin();
+  }
+
+  const T &front() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *cbegin();
+  }
+
+  /*!
+   *  Returns the last element in the list.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &back() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *std::prev(end());
+  }
+
+  const T &back() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return *std::prev(cend());
+  }
+
+  /*!
+   *  Inserts a new element at the beginning of the list.
+   *  \param value_ The value of the element to insert.
+   */
+  void push_front(const T &value_) { construct_front(value_); }
+
+  /*!
+   *  Moves a new element to the beginning of the list.
+   *  \param value_ The value of the element to insert.
+   */
+  void push_front(T &&value_) { construct_front(std::move(value_)); }
+
+  //! Constructs a new element from `args` at the beginning of the list.
+  template <typename... Args>
+  T &emplace_front(Args &&...args) {
+    construct_front(std::forward<Args>(args)...);
+    return *begin();
+  }
+
+  /*!
+   *  Inserts a new element at the end of the list.
+   *  \param value_ The value of the element to insert.
+   */
+  void push_back(const T &value_) { construct_back(value_); }
+
+  /*!
+   *  Moves a new element to the end of the list.
+   *  \param value_ The value of the element to insert.
+   */
+  void push_back(T &&value_) { construct_back(std::move(value_)); }
+
+  //! Constructs a new element from `args` at the end of the list.
+  template <typename... Args>
+  T &emplace_back(Args &&...args) {
+    construct_back(std::forward<Args>(args)...);
+    return *std::prev(end());
+  }
+
+  //! Removes the first element of the list, if any.
+  void pop_front() {
+    if (!empty()) {
+      erase(begin());
+    }
+  }
+
+  /*!
+   *  Removes the last element of the list.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_back() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    Node *last = as_node(m_tail.prev);
+    last->at(--last->count)->~T();
+    if (last->count == 0) {
+      unlink(last);
+      destroy_node(last);
+    }
+    --m_len;
+  }
+
+  //=== [IV-a] MODIFIERS W/ ITERATORS
+  /*!
+   *  Assigns new contents to the list, replacing its current contents.
+   *  \param first_ The beginning of the range.
+   *  \param last_ The end of the range.
+   */
+  template <class InItr>
+  void assign(InItr first_, InItr last_) {
+    clear();
+    for (; first_ != last_; ++first_) {
+      push_back(*first_);
+    }
+  }
+
+  /*!
+   *  Assigns new contents to the list, replacing its current contents.
+   *  \param ilist_ The initializer list to copy from.
+   */
+  void assign(std::initializer_list<T> ilist_) { assign(ilist_.begin(), ilist_.end()); }
+
+  /*!
+   *  Inserts a new value in the list before `pos_`. A full node is split in two first.
+   *  \param pos_ Position before which the value is inserted.
+   *  \param value_ The value to insert.
+   *  \return An iterator to the new element.
+   */
+  iterator insert(const_iterator pos_, const T &value_) { return emplace(pos_, value_); }
+
+  //! Moves `value_` into the list before `pos_`; see insert().
+  iterator insert(const_iterator pos_, T &&value_) { return emplace(pos_, std::move(value_)); }
+
+  /*!
+   *  Constructs a new element from `args` before `pos_`. At the end of the list
+   *  it is built in place; elsewhere it is built aside and moved into the slot
+   *  the shift opens, since the node's elements move anyway.
+   *  \return An iterator to the new element.
+   */
+  template <typename... Args>
+  iterator emplace(const_iterator pos_, Args &&...args) {
+    if (pos_.m_node == &m_tail) {
+      construct_back(std::forward<Args>(args)...);
+      return iterator{m_tail.prev, m_tail.prev->count - 1};
+    }
+
+    T value(std::forward<Args>(args)...); // The arguments may live in a node that is about to be shifted or split.
+    Node *node = as_node(pos_.m_node);
+    size_type idx{pos_.m_idx};
+    if (node->count == N) {
+      Node *right = split(node, node->count / 2);
+      if (idx > node->count) {
+        idx -= node->count;
+        node = right;
+      }
+    }
+    insert_in_node(node, idx, std::move(value));
+    ++m_len;
+    return iterator{node, idx};
+  }
+
+  /*!
+   *  Inserts elements from the range [first_, last_) before `pos_`.
+   *  \return An iterator to the first inserted element, or `pos_` if the range is empty.
+   */
+  template <typename InItr, typename = std::enable_if_t<!std::is_integral<InItr>::value>>
+  iterator insert(const_iterator pos_, InItr first_, InItr last_) {
+    // Splits may move earlier insertions, so only the position after the run is tracked.
+    difference_type count{0};
+    for (; first_ != last_; ++first_, ++count) {
+      pos_ = ++insert(pos_, *first_);
+    }
+    iterator result{pos_.m_node, pos_.m_idx};
+    result -= count;
+    return result;
+  }
+
+  /*!
+   *  Inserts elements from an initializer list before `pos_`.
+   *  \return An iterator to the first inserted element, or `pos_` if the list is empty.
+   */
+  iterator insert(const_iterator pos_, std::initializer_list<T> ilist_) {
+    return insert(pos_, ilist_.begin(), ilist_.end());
+  }
+
+  /*!
+   *  Erases the element at `it_`.
+   *  \return An iterator to the element following the erased one.
+   */
+  iterator erase(const_iterator it_) {
+    const_iterator next{it_};
+    return erase(it_, ++next);
+  }
+
+  /*!
+   *  Erases the elements in [start, end), shifting each affected node only once.
+   *  \return An iterator to the element following the last erased one.
+   */
+  iterator erase(const_iterator start, const_iterator end) {
+    size_type k{0};
+    for (auto it = start; it != end; ++it) {
+      ++k;
+    }
+
+    node_base *node = start.m_node;
+    size_type idx{start.m_idx};
+    while (k > 0) {
+      Node *n = as_node(node);
+      size_type take{std::min(k, n->count - idx)};
+      for (size_type i{idx}; i + take < n->count; ++i) {
+        *n->at(i) = std::move(*n->at(i + take));
+      }
+      for (size_type i{n->count - take}; i < n->count; ++i) {
+        n->at(i)->~T();
+      }
+      n->count -= take;
+      m_len -= take;
+      k -= take;
+
+      if (n->count == 0) {
+        node = n->next;
+        unlink(n);
+        destroy_node(n);
+        idx = 0;
+      } else if (idx == n->count) {
+        node = n->next;
+        idx = 0;
+      }
+    }
+
+    // Keep the nodes dense: let the affected nodes absorb their neighbours.
+    if (node != &m_tail) {
+      try_merge(node);
+    }
+    if (idx == 0 && node->prev != &m_head) {
+      node_base *prev = node->prev;
+      size_type offset{prev->count};
+      if (try_merge(prev)) {
+        return iterator{prev, offset};
+      }
+    }
+    return iterator{node, idx};
+  }
+
+  /*!
+   *  Finds the first occurrence of the specified value in the list.
+   *  \param value_ The value to search for.
+   *  \return An iterator to the first occurrence, or end() if not found.
+   */
+  iterator find(const T &value_) {
+    for (node_base *node = m_head.next; node != &m_tail; node = node->next) {
+      size_type i = simd::find(as_node(node)->at(0), node->count, value_);
+      if (i != node->count) {
+        return iterator{node, i};
+      }
+    }
+    return end();
+  }
+
+  /*!
+   *  Finds the first occurrence of the specified value in the list (const version).
+   *  \param value_ The value to search for.
+   *  \return An iterator to the first occurrence, or cend() if not found.
+   */
+  const_iterator find(const T &value_) const {
+    return const_cast<unrolled_list *>(this)->find(value_);
+  }
+
+  //=== [IV-b] Operations
+  // Whole nodes are relinked where possible; elements only move inside a node
+  // or when two lists have to be interleaved.
+
+  /*!
+   *  Moves every element of `other` into this list, before `pos`. The nodes of
+   *  `other` are relinked as they are; only the nodes where the chains meet
+   *  are split or merged, so the cost is O(N) whatever the length of `other`.
+   *  \param pos Position in this list before which the elements are inserted.
+   *  \param other The list to take the elements from; it is left empty.
+   */
+  void splice(const_iterator pos, unrolled_list &other) {
+    if (&other == this || other.empty()) { return; }
+    node_base *first = other.m_head.next;
+    node_base *last = other.m_tail.prev;
+    size_type count{other.m_len};
+    other.init_sentinels();
+    other.m_len = 0;
+    hang_before(pos, first, last, count);
+  }
+
+  /*!
+   *  Moves the element at `it` from `other` into this list, before `pos`.
+   *  From another list the element is moved into a slot here and erased
+   *  there; within this list the elements in between are rotated by one.
+   */
+  void splice(const_iterator pos, unrolled_list &other, const_iterator it) {
+    if (&other != this) {
+      emplace(pos, std::move(*mutable_of(it)));
+      other.erase(it);
+      return;
+    }
+    const_iterator next{it};
+    splice(pos, other, it, ++next);
+  }
+
+  /*!
+   *  Moves the elements of [first, last) from `other` into this list, before `pos`.
+   *  From another list, `other` is split where the range starts and ends and
+   *  the whole nodes in between are relinked, so the cost is O(N) plus one step
+   *  per node of the range. Within this list the range is rotated into place,
+   *  which moves the elements between it and `pos`.
+   */
+  void splice(const_iterator pos, unrolled_list &other, const_iterator first, const_iterator last) {
+    if (first == last) { return; }
+    if (&other == this) {
+      if (pos == first || pos == last) { return; }
+      iterator a = mutable_of(first);
+      iterator b = mutable_of(last);
+      iterator at = mutable_of(pos);
+      if (index_of(pos) < index_of(first)) {
+        std::rotate(at, a, b);
+      } else {
+        std::rotate(a, b, at);
+      }
+      return;
+    }
+
+    // Cut the range out of `other` as a chain of whole nodes.
+    node_base *head = first.m_node;
+    if (first.m_idx != 0) {
+      head = other.split(as_node(head), first.m_idx);
+      if (last.m_node == first.m_node) {
+        last = const_iterator{head, last.m_idx - first.m_idx};
+      }
+    }
+    node_base *after = last.m_node;
+    if (last.m_idx != 0) {
+      after = other.split(as_node(after), last.m_idx);
+    }
+    node_base *tail = after->prev;
+    size_type count{0};
+    for (node_base *node = head; node != after; node = node->next) {
+      count += node->count;
+    }
+    node_base *before_range = head->prev;
+    before_range->next = after;
+    after->prev = before_range;
+    other.m_len -= count;
+    other.try_merge(before_range);
+
+    hang_before(pos, head, tail, count);
+  }
+
+  /*!
+   *  Merges the sorted list `other` into this sorted list; equal elements of
+   *  this list come first. The elements are moved into freshly packed nodes,
+   *  since two interleaved lists cannot keep their nodes.
+   *  \param other The list to merge from; it is left empty.
+   */
+  void merge(unrolled_list &other) {
+    if (&other == this || other.empty()) { return; }
+    unrolled_list merged;
+    merged.m_alloc = m_alloc;
+    iterator a = begin();
+    iterator b = other.begin();
+    while (a != end() && b != other.end()) {
+      if (*b < *a) {
+        merged.push_back(std::move(*b++));
+      } else {
+        merged.push_back(std::move(*a++));
+      }
+    }
+    for (; a != end(); ++a) { merged.push_back(std::move(*a)); }
+    for (; b != other.end(); ++b) { merged.push_back(std::move(*b)); }
+    other.clear();
+    clear();
+    swap(merged);
+  }
+
+  //! Reverses the order of the elements: the nodes are relinked backwards and each one is reversed in place.
+  void reverse() {
+    node_base *node = m_head.next;
+    while (node != &m_tail) {
+      node_base *next = node->next;
+      std::swap(node->next, node->prev);
+      std::reverse(as_node(node)->at(0), as_node(node)->at(0) + node->count);
+      node = next;
+    }
+    if (!empty()) {
+      adopt_chain(m_tail.prev, m_head.next);
+    }
+  }
+
+  //! Removes every element equal to the one before it, shifting the survivors forward in one pass.
+  void unique() {
+    if (empty()) { return; }
+    iterator kept = begin();
+    for (iterator it = std::next(begin()); it != end(); ++it) {
+      if (!(*it == *kept)) {
+        ++kept;
+        if (kept != it) {
+          *kept = std::move(*it);
+        }
+      }
+    }
+    erase(++kept, end());
+  }
+
+  //! Sorts the list in non-descending order (stable, never allocates).
+  void sort() { sort([](const T &a, const T &b) { return a < b; }); }
+
+  /*!
+   *  Sorts the list according to `comp`. The sort is stable and never
+   *  allocates: each node is sorted in place by insertion, then runs of
+   *  1, 2, 4... nodes are merged in place by rotations, in O(n log² n) moves
+   *  at worst. The nodes keep their layout; only the elements move between
+   *  the slots.
+   *  \param comp Returns true if its first argument goes before the second.
+   */
+  template <typename Compare>
+  void sort(Compare comp) {
+    if (m_len < 2) { return; }
+    size_type nodes{0};
+    for (node_base *node = m_head.next; node != &m_tail; node = node->next) {
+      ++nodes;
+      T *a = as_node(node)->at(0);
+      for (size_type i{1}; i < node->count; ++i) {
+        if (comp(a[i], a[i - 1])) {
+          T value = std::move(a[i]);
+          size_type j{i};
+          do {
+            a[j] = std::move(a[j - 1]);
+            --j;
+          } while (j > 0 && comp(value, a[j - 1]));
+          a[j] = std::move(value);
+        }
+      }
+    }
+
+    for (size_type width{1}; width < nodes; width *= 2) {
+      node_base *left = m_head.next;
+      while (left != &m_tail) {
+        node_base *middle = left;
+        size_type len1{0};
+        for (size_type k{0}; k < width && middle != &m_tail; ++k, middle = middle->next) {
+          len1 += middle->count;
+        }
+        if (middle == &m_tail) { break; }
+        node_base *right = middle;
+        size_type len2{0};
+        for (size_type k{0}; k < width && right != &m_tail; ++k, right = right->next) {
+          len2 += right->count;
+        }
+        merge_in_place(iterator{left, 0}, iterator{middle, 0}, len1, len2, comp);
+        left = right;
+      }
+    }
+  }
+
+  //=== [V] Scans
+  // Each node's elements are contiguous, so these work a whole node at a time
+  // with the vector kernels of simd.h.
+
+  //! Returns true if some element is equal to `value_`.
+  bool contains(const T &value_) const {
+    return find(value_) != cend();
+  }
+
+  //! Returns how many elements are equal to `value_`.
+  size_type count(const T &value_) const {
+    size_type total{0};
+    for (node_base *node = m_head.next; node != &m_tail; node = node->next) {
+      total += simd::count(as_node(node)->at(0), node->count, value_);
+    }
+    return total;
+  }
+
+  /*!
+   *  Returns the smallest element.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  const T &min() const { return extreme<false>(); }
+
+  /*!
+   *  Returns the largest element.
+   *  \throw std::out_of_range if the list is empty.
+   */
+  const T &max() const { return extreme<true>(); }
+
+  /*!
+   *  Adds every element to `init`, in order. Integer sums wrap around.
+   *  \param init The starting value.
+   *  \return The sum.
+   */
+  T accumulate(T init = T{}) const {
+    for (node_base *node = m_head.next; node != &m_tail; node = node->next) {
+      init = simd::accumulate(as_node(node)->at(0), node->count, init);
+    }
+    return init;
+  }
+
+  /*!
+   *  Returns true if both lists hold equal elements in the same order. The
+   *  nodes of the two lists may be filled differently, so the comparison walks
+   *  both and compares the longest run that is contiguous in each.
+   */
+  bool equals(const unrolled_list &other) const {
+    if (m_len != other.m_len) { return false; }
+    node_base *a = m_head.next;
+    node_base *b = other.m_head.next;
+    size_type ia{0}, ib{0};
+    while (a != &m_tail) {
+      size_type run = std::min(a->count - ia, b->count - ib);
+      if (!simd::equal(as_node(a)->at(ia), as_node(b)->at(ib), run)) {
+        return false;
+      }
+      ia += run;
+      ib += run;
+      if (ia == a->count) { a = a->next; ia = 0; }
+      if (ib == b->count) { b = b->next; ib = 0; }
+    }
+    return true;
+  }
+
+private:
+  //! The smallest (`Max == false`) or largest element, computed node by node.
+  template <bool Max>
+  const T &extreme() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    const T *best = nullptr;
+    for (node_base *node = m_head.next; node != &m_tail; node = node->next) {
+      Node *n = as_node(node);
+      const T *candidate = n->at(simd::extreme<Max>(n->at(0), n->count));
+      if (best == nullptr || (Max ? *best < *candidate : *candidate < *best)) {
+        best = candidate;
+      }
+    }
+    return *best;
+  }
+};
+
+//=== [VI] OPERATORS
+
+/*!
+ *  Equality comparison operator. Checks if two lists hold the same elements in the same order.
+ */
+template <typename T, std::size_t N, typename Alloc>
+inline bool operator==(const unrolled_list<T, N, Alloc> &l1_, const unrolled_list<T, N, Alloc> &l2_) {
+  return l1_.equals(l2_);
+}
+
+//! Inequality comparison operator.
+template <typename T, std::size_t N, typename Alloc>
+inline bool operator!=(const unrolled_list<T, N, Alloc> &l1_, const unrolled_list<T, N, Alloc> &l2_) {
+  return !(l1_ == l2_);
+}
+
+} // namespace sc
+#endif
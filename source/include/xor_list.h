@@ -0,0 +1,380 @@
+#ifndef _XOR_LIST_H_
+#define _XOR_LIST_H_
+
+#include <cstddef>          // std::size_t, std::ptrdiff_t
+#include <cstdint>          // std::uintptr_t
+#include <initializer_list>
+#include <iterator>         // bidirectional_iterator_tag
+#include <memory>           // std::allocator_traits
+#include <stdexcept>        // std::out_of_range
+#include <type_traits>
+#include <utility>          // std::move, std::forward, std::swap
+
+#include "pool_allocator.h"
+
+namespace sc {
+
+/*!
+ *  \class xor_list
+ *  \brief Doubly-linked list that keeps a single link word per node: `prev ^ next`.
+ *
+ *  A node is one word plus the element, 8 bytes smaller than an `sc::list`
+ *  node. Walking needs the node you came from to decode the link, so an
+ *  iterator carries two pointers (the previous node and the current one) and
+ *  each step costs an extra XOR. Both ends are reachable, so iteration works
+ *  forwards from begin() and backwards from end(), and `reverse()` is O(1):
+ *  it only swaps the two ends.
+ *
+ *  \note An iterator remembers its neighbour, so inserting or erasing next
+ *  to it invalidates it, unlike in `sc::list`. Use the iterators returned by
+ *  `insert()` and `erase()` to keep going.
+ *
+ *  \tparam T The type of the elements.
+ *  \tparam Alloc The allocator used for the nodes (rebound to the node type).
+ */
+template <typename T, typename Alloc = sc::pool_allocator<T>>
+class xor_list {
+  //! A node: the XOR of the addresses of its neighbours (null past the ends), plus the element.
+  struct Node {
+    std::uintptr_t link;
+    T data;
+
+    template <typename... Args>
+    explicit Node(Args &&...args) : link{0}, data(std::forward<Args>(args)...) { }
+  };
+
+  static std::uintptr_t bits(const Node *node) { return reinterpret_cast<std::uintptr_t>(node); }
+
+  //! The neighbour of `node` that is not `from`.
+  static Node *other_side(const Node *node, const Node *from) {
+    return reinterpret_cast<Node *>(node->link ^ bits(from));
+  }
+
+  //! Replaces the neighbour `from` of `node` with `to`.
+  static void relink(Node *node, const Node *from, const Node *to) {
+    node->link ^= bits(from) ^ bits(to);
+  }
+
+  /*!
+   *  \class iterator_impl
+   *  \brief Bidirectional iterator over a XOR list: the previous node and the current one.
+   *  \tparam Const Whether this iterator gives read-only access.
+   */
+  template <bool Const>
+  class iterator_impl {
+  public:
+    using value_type = T;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+  private:
+    Node *m_prev; //!< The node before the current one; null at begin().
+    Node *m_cur;  //!< The current node; null at end().
+
+  public:
+    iterator_impl(Node *prev = nullptr, Node *cur = nullptr) : m_prev{prev}, m_cur{cur} { }
+
+    //! A mutable iterator converts to a const one.
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    iterator_impl(const iterator_impl<false> &other) : m_prev{other.m_prev}, m_cur{other.m_cur} { }
+
+    reference operator*() const { return m_cur->data; }
+    pointer operator->() const { return &m_cur->data; }
+
+    iterator_impl &operator++() {
+      Node *next = other_side(m_cur, m_prev);
+      m_prev = m_cur;
+      m_cur = next;
+      return *this;
+    }
+
+    iterator_impl operator++(int) {
+      iterator_impl temp{*this};
+      ++*this;
+      return temp;
+    }
+
+    iterator_impl &operator--() {
+      Node *before = other_side(m_prev, m_cur);
+      m_cur = m_prev;
+      m_prev = before;
+      return *this;
+    }
+
+    iterator_impl operator--(int) {
+      iterator_impl temp{*this};
+      --*this;
+      return temp;
+    }
+
+    bool operator==(const iterator_impl &rhs) const { return m_cur == rhs.m_cur && m_prev == rhs.m_prev; }
+    bool operator!=(const iterator_impl &rhs) const { return !(*this == rhs); }
+
+    friend class xor_list;
+    friend class iterator_impl<!Const>;
+  };
+
+  using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Alloc;
+  using iterator = iterator_impl<false>;      //!< Mutable iterator.
+  using const_iterator = iterator_impl<true>; //!< Read-only iterator.
+
+  //=== [I] Special members
+  //! \brief Constructs an empty list.
+  xor_list() = default;
+
+  //! \brief Constructs a list with the elements of [first, last).
+  template <typename InputIt>
+  xor_list(InputIt first, InputIt last) {
+    try {
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  //! \brief Constructs a list with the elements of an initializer list.
+  xor_list(std::initializer_list<T> ilist_) : xor_list(ilist_.begin(), ilist_.end()) { }
+
+  xor_list(const xor_list &other) : xor_list(other.cbegin(), other.cend()) { }
+
+  //! \brief Takes over the nodes of `other`, which is left empty.
+  xor_list(xor_list &&other) noexcept : m_alloc(std::move(other.m_alloc)) { swap(other); }
+
+  xor_list &operator=(const xor_list &rhs) {
+    if (this != &rhs) {
+      xor_list temp(rhs);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  xor_list &operator=(xor_list &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      swap(rhs);
+    }
+    return *this;
+  }
+
+  ~xor_list() { clear(); }
+
+  void swap(xor_list &other) noexcept {
+    std::swap(m_head, other.m_head);
+    std::swap(m_tail, other.m_tail);
+    std::swap(m_len, other.m_len);
+    std::swap(m_alloc, other.m_alloc);
+  }
+
+  //=== [II] Iterators
+  iterator begin() { return iterator{nullptr, m_head}; }
+  iterator end() { return iterator{m_tail, nullptr}; }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+  const_iterator cbegin() const { return const_iterator{nullptr, m_head}; }
+  const_iterator cend() const { return const_iterator{m_tail, nullptr}; }
+
+  //=== [III] Capacity/Status
+  [[nodiscard]] bool empty() const { return m_len == 0; }
+  [[nodiscard]] size_type size() const { return m_len; }
+
+  //=== [IV] Access
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &front() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return m_head->data;
+  }
+
+  const T &front() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return m_head->data;
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  T &back() {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return m_tail->data;
+  }
+
+  const T &back() const {
+    if (empty()) { throw std::out_of_range("A lista está vazia"); }
+    return m_tail->data;
+  }
+
+  //=== [V] Modifiers
+  //! Removes all elements from the list.
+  void clear() {
+    Node *prev = nullptr;
+    for (Node *cur = m_head; cur != nullptr;) {
+      Node *next = other_side(cur, prev);
+      prev = cur;
+      destroy_node(cur);
+      cur = next;
+    }
+    m_head = m_tail = nullptr;
+    m_len = 0;
+  }
+
+  void push_front(const T &value_) { emplace_front(value_); }
+  void push_front(T &&value_) { emplace_front(std::move(value_)); }
+  void push_back(const T &value_) { emplace_back(value_); }
+  void push_back(T &&value_) { emplace_back(std::move(value_)); }
+
+  template <typename... Args>
+  T &emplace_front(Args &&...args) { return *emplace(cbegin(), std::forward<Args>(args)...); }
+
+  template <typename... Args>
+  T &emplace_back(Args &&...args) { return *emplace(cend(), std::forward<Args>(args)...); }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_front() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(cbegin());
+  }
+
+  /*!
+   *  \throw std::out_of_range if the list is empty.
+   */
+  void pop_back() {
+    if (empty()) { throw std::out_of_range("Lista vazia"); }
+    erase(--cend());
+  }
+
+  /*!
+   *  Constructs a new element right before `pos`.
+   *  \return An iterator to the new element. `pos` itself is no longer valid.
+   */
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    Node *node = create_node(std::forward<Args>(args)...);
+    Node *prev = pos.m_prev;
+    Node *next = pos.m_cur;
+    node->link = bits(prev) ^ bits(next);
+    if (prev != nullptr) { relink(prev, next, node); } else { m_head = node; }
+    if (next != nullptr) { relink(next, prev, node); } else { m_tail = node; }
+    ++m_len;
+    return iterator{prev, node};
+  }
+
+  iterator insert(const_iterator pos, const T &value_) { return emplace(pos, value_); }
+  iterator insert(const_iterator pos, T &&value_) { return emplace(pos, std::move(value_)); }
+
+  /*!
+   *  Removes the element at `pos`.
+   *  \return An iterator to the element that followed it.
+   */
+  iterator erase(const_iterator pos) {
+    Node *prev = pos.m_prev;
+    Node *node = pos.m_cur;
+    Node *next = other_side(node, prev);
+    if (prev != nullptr) { relink(prev, node, next); } else { m_head = next; }
+    if (next != nullptr) { relink(next, node, prev); } else { m_tail = prev; }
+    destroy_node(node);
+    --m_len;
+    return iterator{prev, next};
+  }
+
+  //=== [VI] Operations
+  //! Finds the first element equal to `value_`, or returns end().
+  iterator find(const T &value_) {
+    iterator it = begin();
+    while (it != end() && !(*it == value_)) {
+      ++it;
+    }
+    return it;
+  }
+
+  const_iterator find(const T &value_) const {
+    const_iterator it = cbegin();
+    while (it != cend() && !(*it == value_)) {
+      ++it;
+    }
+    return it;
+  }
+
+  /*!
+   *  Moves every element of `other` right before `pos`, in O(1).
+   *  \note The allocators of both lists must compare equal.
+   */
+  void splice(const_iterator pos, xor_list &other) {
+    if (this == &other || other.empty()) {
+      return;
+    }
+    Node *prev = pos.m_prev;
+    Node *next = pos.m_cur;
+    Node *first = other.m_head;
+    Node *last = other.m_tail;
+    // The ends of the moved chain pointed to null; now they point to their new neighbours.
+    first->link ^= bits(prev);
+    last->link ^= bits(next);
+    if (prev != nullptr) { relink(prev, next, first); } else { m_head = first; }
+    if (next != nullptr) { relink(next, prev, last); } else { m_tail = last; }
+    m_len += other.m_len;
+    other.m_head = other.m_tail = nullptr;
+    other.m_len = 0;
+  }
+
+  //! Reverses the order of the elements in O(1): the links read the same both ways.
+  void reverse() noexcept { std::swap(m_head, m_tail); }
+
+private:
+  Node *m_head{nullptr}; //!< First node, or null.
+  Node *m_tail{nullptr}; //!< Last node, or null.
+  size_type m_len{0};
+  node_allocator m_alloc;
+
+  template <typename... Args>
+  Node *create_node(Args &&...args) {
+    Node *node = node_traits::allocate(m_alloc, 1);
+    try {
+      node_traits::construct(m_alloc, node, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(m_alloc, node, 1);
+      throw;
+    }
+    return node;
+  }
+
+  void destroy_node(Node *node) {
+    node_traits::destroy(m_alloc, node);
+    node_traits::deallocate(m_alloc, node, 1);
+  }
+};
+
+//! Two XOR lists are equal if they hold equal elements in the same order.
+template <typename T, typename A>
+bool operator==(const xor_list<T, A> &a, const xor_list<T, A> &b) {
+  if (a.size() != b.size()) { return false; }
+  auto it = b.cbegin();
+  for (const T &value : a) {
+    if (!(value == *it++)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T, typename A>
+bool operator!=(const xor_list<T, A> &a, const xor_list<T, A> &b) {
+  return !(a == b);
+}
+
+} // namespace sc
+#endif
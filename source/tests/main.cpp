@@ -1,10 +1,32 @@
 #include<iostream>
 #include<list>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 
 #include "include/tm/test_manager.h"
 #include "../include/list.h"
+#include "../include/unrolled_list.h"
+#include "../include/intrusive_list.h"
+#include "../include/mpsc_list.h"
+#include "../include/indexed_list.h"
+#include "../include/lru_cache.h"
+#include "../include/mapped_list.h"
+#include "../include/compact_list.h"
+#include "../include/xor_list.h"
+#include "../include/express_list.h"
 
 #define which_lib sc 
 // #define which_lib std
@@ -23,6 +45,54 @@ std::ostream & operator<<( std::ostream &os, const which_lib::list<T> & L )
     return os;
 }
 
+//! Allocator that counts the calls to allocate(), to check which operations hit the allocator.
+template < typename T >
+struct counting_allocator
+{
+    using value_type = T;
+    int *calls;
+
+    counting_allocator( int *c ) : calls{ c } {}
+    template < typename U >
+    counting_allocator( const counting_allocator<U> &other ) : calls{ other.calls } {}
+
+    T *allocate( std::size_t n ) { ++*calls; return std::allocator<T>{}.allocate( n ); }
+    void deallocate( T *p, std::size_t n ) { std::allocator<T>{}.deallocate( p, n ); }
+
+    template < typename U >
+    bool operator==( const counting_allocator<U> &rhs ) const { return calls == rhs.calls; }
+    template < typename U >
+    bool operator!=( const counting_allocator<U> &rhs ) const { return calls != rhs.calls; }
+};
+
+//! Stateless allocator counting every allocation in a shared tally.
+template < typename T >
+struct tally_allocator
+{
+    using value_type = T;
+    static inline int calls = 0;
+
+    tally_allocator() = default;
+    template < typename U >
+    tally_allocator( const tally_allocator<U> & ) {}
+
+    T *allocate( std::size_t n ) { ++calls; return std::allocator<T>{}.allocate( n ); }
+    void deallocate( T *p, std::size_t n ) { std::allocator<T>{}.deallocate( p, n ); }
+
+    template < typename U >
+    bool operator==( const tally_allocator<U> & ) const { return true; }
+    template < typename U >
+    bool operator!=( const tally_allocator<U> & ) const { return false; }
+};
+
+//! Whether an element can be assigned through an iterator of type `It`.
+template < typename It, typename = void >
+struct writable_through : std::false_type {};
+
+template < typename It >
+struct writable_through< It, std::void_t< decltype( *std::declval<It &>() = *std::declval<It &>() ) > >
+    : std::true_type {};
+
 int main(  )
 {
     //=== TESTING BASIC OPERATIONS METHODS
@@ -110,22 +180,25 @@ int main(  )
             EXPECT_EQ( i, *e++ );
         }
     }
-#ifdef MOVE_SYNTAX_IMPLEMENTED
-
-    // {
-    //     BEGIN_TEST(tm, "Molistonstructor", "move the elements from another");
-    //     // Range = the entire list.
-    //     which_lib::list<int> list{ 1, 2, 3, 4, 5 };
-    //     which_lib::list<int> list2( std::move( list ) );
+    {
+        BEGIN_TEST(tm, "MoveConstructor", "move the elements from another");
+        // Range = the entire list.
+        which_lib::list<int> list{ 1, 2, 3, 4, 5 };
+        const int *first_node{ &*list.begin() };
+        which_lib::list<int> list2( std::move( list ) );
 
-    //     EXPECT_EQ( list2.size(), 5 );
-    //     // EXPECT_FALSE( list2.empty() );
+        EXPECT_EQ( list2.size(), 5 );
+        EXPECT_FALSE( list2.empty() );
+        EXPECT_TRUE( list.empty() );
+        // The nodes were taken over, not copied.
+        EXPECT_EQ( first_node, &*list2.begin() );
 
-    //     // CHeck whether the copy worked.
-    //     for( auto i{0u} ; i < list2.size() ; ++i )
-    //         EXPECT_EQ( i+1, list2[i] );
-    // }
-#endif
+        // CHeck whether the move worked.
+        auto i{1};
+        for( auto e = list2.begin() ; e != list2.end() ; ++i){
+            EXPECT_EQ( i, *e++ );
+        }
+    }
 
 
     {
@@ -205,25 +278,50 @@ int main(  )
 
  
 
-#ifdef MOVE_SYNTAX_IMPLEMENTED  
-    // // {
-    // //     BEGIN_TEST(tm, "MoveAssignOperator", "MoveAssignOperator");
-    // //     // Range = the entire list.
-    // //     which_lib::list<int> list{ 1, 2, 3, 4, 5 };
-    // //     which_lib::list<int> list2;
-
-    // //     list2 = std::move( list );
-    // //     EXPECT_EQ( list2.size(), 5 );
-    // //     EXPECT_FALSE( list2.empty() );
-    // //     EXPECT_EQ( list.size(), 0 );
-    // //     EXPECT_EQ( list.capacity(), 0 );
-    // //     EXPECT_TRUE( list.empty() );
-
-    // //     // CHeck whether the copy worked.
-    // //     for( auto i{0u} ; i < list2.size() ; ++i )
-    // //         EXPECT_EQ( i+1, list2[i] );
-    // // }
-#endif
+    {
+        BEGIN_TEST(tm, "MoveAssignOperator", "MoveAssignOperator");
+        // Range = the entire list.
+        which_lib::list<int> list{ 1, 2, 3, 4, 5 };
+        which_lib::list<int> list2{ 7, 8 };
+
+        list2 = std::move( list );
+        EXPECT_EQ( list2.size(), 5 );
+        EXPECT_FALSE( list2.empty() );
+        EXPECT_EQ( list.size(), 0 );
+        EXPECT_TRUE( list.empty() );
+
+        // CHeck whether the move worked.
+        auto i{1};
+        for( auto e = list2.begin() ; e != list2.end() ; ++i){
+            EXPECT_EQ( i, *e++ );
+        }
+    }
+
+    {
+        BEGIN_TEST(tm, "Emplace", "emplace and rvalue push construct elements in place.");
+        which_lib::list<std::string> list;
+        list.emplace_back( 3, 'b' );
+        list.emplace_front( "aa" );
+        auto it = list.emplace( std::next( list.begin() ), 2, 'x' );
+        EXPECT_EQ( *it, "xx" );
+        EXPECT_EQ( list.emplace_back( "z" ), "z" );
+        EXPECT_EQ( list, ( which_lib::list<std::string>{ "aa", "xx", "bbb", "z" } ) );
+
+        // Moving a string into the list steals its buffer.
+        std::string big( 100, 'q' );
+        const char *buffer{ big.data() };
+        list.push_back( std::move( big ) );
+        EXPECT_EQ( buffer, std::prev( list.end() )->data() );
+        EXPECT_EQ( std::prev( list.end() )->size(), 100 );
+
+        std::string front( 100, 'f' );
+        buffer = front.data();
+        list.push_front( std::move( front ) );
+        EXPECT_EQ( buffer, list.begin()->data() );
+        list.insert( list.begin(), std::string( 4, 'i' ) );
+        EXPECT_EQ( *list.begin(), "iiii" );
+        EXPECT_EQ( list.size(), 7 );
+    }
 
 
     {
@@ -667,6 +765,176 @@ past_last = list.erase( std::next(list.begin(),2) );
         EXPECT_TRUE( list4.empty() );
     }
 
+    {
+        BEGIN_TEST(tm, "PoolAllocator","nodes are recycled by the pool allocator");
+        which_lib::list<int> list { 1, 2, 3 };
+        const int *last_node = &*std::prev( list.end() );
+
+        // A freed node must be handed back by the next allocation.
+        list.pop_back();
+        list.push_back( 4 );
+        EXPECT_EQ( last_node, &*std::prev( list.end() ) );
+        EXPECT_EQ( list, ( which_lib::list<int>{ 1, 2, 4 } ) );
+
+        // Lists with a standard allocator still work as before.
+        which_lib::list<int, std::allocator<int>> list2 { 1, 2, 3 };
+        list2.push_front( 0 );
+        list2.pop_back();
+        EXPECT_EQ( list2, ( which_lib::list<int, std::allocator<int>>{ 0, 1, 2 } ) );
+
+        // A thread gives its cached nodes back when it exits, so the next threads reuse them.
+        struct Bulky { int value; char pad[116]; };
+        auto churn = []() {
+            which_lib::list<Bulky> nodes;
+            for ( int i{0}; i < 5000; ++i ) nodes.push_back( Bulky{ i, {} } );
+        };
+        for ( int i{0}; i < 3; ++i ) std::thread( churn ).join();
+        auto blocks = which_lib::pool_allocator<int>::system_blocks();
+        for ( int i{0}; i < 20; ++i ) std::thread( churn ).join();
+        EXPECT_EQ( which_lib::pool_allocator<int>::system_blocks(), blocks );
+    }
+
+    {
+        BEGIN_TEST(tm, "Sentinels","empty lists, clear and moves never allocate.");
+        struct NoDefault { int v; explicit NoDefault( int x ) : v{ x } {} };
+        which_lib::list<NoDefault> list;
+        list.emplace_back( 1 );
+        list.emplace_front( 0 );
+        EXPECT_EQ( list.front().v, 0 );
+        EXPECT_EQ( list.back().v, 1 );
+
+        // Only the elements themselves cost an allocation.
+        int calls{ 0 };
+        using counted_list = which_lib::list<int, counting_allocator<int>>;
+        {
+            counted_list list2( counting_allocator<int>{ &calls } );
+            EXPECT_EQ( calls, 0 );
+        }
+        EXPECT_EQ( calls, 0 );
+        counted_list list3( counting_allocator<int>{ &calls } );
+        list3.push_back( 1 );
+        list3.push_back( 2 );
+        EXPECT_EQ( calls, 2 );
+        list3.clear();
+        EXPECT_EQ( calls, 2 );
+        list3.push_back( 3 );
+        counted_list list4( std::move( list3 ) );
+        counted_list list5( counting_allocator<int>{ &calls } );
+        list5.swap( list4 );
+        EXPECT_EQ( calls, 3 );
+        EXPECT_TRUE( list3.empty() );
+        EXPECT_TRUE( list4.empty() );
+        EXPECT_EQ( list5.size(), 1u );
+        EXPECT_EQ( *list5.begin(), 3 );
+        list5.pop_back();
+        EXPECT_TRUE( ( list5.begin() == list5.end() ) );
+    }
+
+    {
+        BEGIN_TEST(tm, "Statistics","statistics policies count allocations, sizes and traversals.");
+        // The default policy keeps nothing and costs nothing.
+        which_lib::list<int> plain { 1, 2, 3 };
+        EXPECT_EQ( plain.stats().allocations, 0u );
+        EXPECT_EQ( plain.stats().nodes_traversed, 0u );
+
+        using local_list = which_lib::list<int, which_lib::pool_allocator<int>, which_lib::local_stats>;
+        local_list list { 1, 2, 3, 4, 5 };
+        list.push_back( 6 );
+        list.pop_front();
+        EXPECT_EQ( list.stats().allocations, 6u );
+        EXPECT_EQ( list.stats().deallocations, 1u );
+        EXPECT_EQ( list.stats().peak_size, 6u );
+        EXPECT_TRUE( ( list.stats().bytes_held >= 5 * sizeof( int ) ) );
+        list.find( 4 );
+        EXPECT_EQ( list.stats().nodes_traversed, 3u );
+        auto first = list.begin();
+        auto last = first;
+        last += 2;
+        list.erase( first, last );
+        EXPECT_EQ( list.stats().nodes_traversed, 5u );
+        EXPECT_EQ( list.stats().deallocations, 3u );
+
+        struct tag {};
+        using global = which_lib::global_stats<tag>;
+        using global_list = which_lib::list<int, which_lib::pool_allocator<int>, global>;
+        {
+            global_list a { 1, 2, 3 };
+            global_list b { 4 };
+            a.splice( a.end(), b );
+            auto it = a.begin();
+            it += 3;
+            EXPECT_EQ( global::global_snapshot().peak_size, 4u );
+        }
+        auto snap = global::global_snapshot();
+        EXPECT_EQ( snap.allocations, 4u );
+        EXPECT_EQ( snap.deallocations, 4u );
+        EXPECT_EQ( snap.bytes_held, 0u );
+        EXPECT_EQ( snap.nodes_traversed, 3u );
+        global::reset();
+        EXPECT_EQ( global::global_snapshot().allocations, 0u );
+    }
+
+    {
+        BEGIN_TEST(tm, "PositionalAccess","at() and nth() walk from the closest of head, tail and last position.");
+        using local_list = which_lib::list<int, which_lib::pool_allocator<int>, which_lib::local_stats>;
+        local_list list;
+        const int n = 1000;
+        for ( int i{0} ; i < n ; ++i ) list.push_back( i );
+
+        bool ok = true;
+        for ( int i{0} ; i < n ; ++i ) ok = ok && list.at( i ) == i;
+        EXPECT_TRUE( ok );
+        // One step per index, plus the first one from the head.
+        EXPECT_EQ( list.stats().nodes_traversed, size_t( n ) );
+
+        // The remembered position follows pushes and pops at both ends.
+        list.at( 500 );
+        list.push_back( n );
+        list.push_front( -1 );
+        list.pop_front();
+        list.pop_front();
+        list.pop_back();
+        auto before = list.stats().nodes_traversed;
+        EXPECT_EQ( list.at( 499 ), 500 );
+        EXPECT_EQ( list.at( 500 ), 501 );
+        EXPECT_EQ( list.stats().nodes_traversed - before, 1u );
+
+        // Near the ends the sentinels are closer.
+        before = list.stats().nodes_traversed;
+        EXPECT_EQ( list.at( 997 ), 998 );
+        EXPECT_EQ( list.at( 1 ), 2 );
+        EXPECT_EQ( list.stats().nodes_traversed - before, 4u );
+
+        // Erasing next to it keeps it; anything farther makes the list forget it.
+        list.erase( list.nth( 2 ) );
+        EXPECT_EQ( list.at( 1 ), 2 );
+        EXPECT_EQ( list.at( 2 ), 4 );
+        list.erase( list.nth( 500 ) );
+        list.reverse();
+        EXPECT_EQ( list.at( 0 ), 999 );
+        EXPECT_EQ( list.at( 1 ), 998 );
+        EXPECT_TRUE( ( list.nth( list.size() ) == list.end() ) );
+        EXPECT_EQ( *list.nth( list.size() - 1 ), 1 );
+
+        bool thrown = false;
+        try { list.at( list.size() ); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        thrown = false;
+        try { list.nth( list.size() + 1 ); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+
+        const local_list &view = list;
+        EXPECT_EQ( view.at( 2 ), 997 );
+        EXPECT_EQ( *view.nth( 3 ), 996 );
+        // Const access reads the remembered position but never moves it.
+        list.at( 500 );
+        view.at( 10 );
+        view.nth( 900 );
+        before = list.stats().nodes_traversed;
+        list.at( 501 );
+        EXPECT_EQ( list.stats().nodes_traversed - before, 1u );
+    }
+
     tm.summary();
 
 
@@ -822,6 +1090,23 @@ past_last = list.erase( std::next(list.begin(),2) );
             EXPECT_EQ( *it++ , i++ );
     }
 
+    {
+        BEGIN_TEST(tm2, "operator-(iterator)", "counts the elements between two iterators.");
+        which_lib::list<int> list{ 1, 2, 3, 4, 5 };
+        auto first = list.begin();
+        auto last = list.end();
+        EXPECT_EQ( last - first, 5 );
+        EXPECT_EQ( first - last, -5 );
+        EXPECT_EQ( list.find( 4 ) - list.find( 2 ), 2 );
+        EXPECT_EQ( list.cend() - list.cbegin(), 5 );
+        EXPECT_EQ( first - first, 0 );
+
+        which_lib::list<int> other{ 1, 2 };
+        bool thrown{ false };
+        try { other.begin() - first; } catch ( const std::invalid_argument & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
     std::cout << std::endl;
     tm2.summary();
 
@@ -964,6 +1249,47 @@ past_last = list.erase( std::next(list.begin(),2) );
         }
     }
 
+    {
+        BEGIN_TEST(tm3, "Splice 6", "splicing a single element.");
+        which_lib::list<int> list_a{ 1, 2, 3 };
+        which_lib::list<int> list_b{ 10, 20, 30 };
+        auto moved{ std::next( list_b.cbegin() ) };
+        const int *node{ &*moved };
+
+        list_a.splice( std::next( list_a.cbegin() ), list_b, moved );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 20, 2, 3 } ) );
+        EXPECT_EQ( list_b, ( which_lib::list<int>{ 10, 30 } ) );
+        EXPECT_EQ( list_a.size(), 4 );
+        EXPECT_EQ( list_b.size(), 2 );
+        EXPECT_EQ( node, &*std::next( list_a.cbegin() ) ); // Same node, not a copy.
+
+        // Moving an element inside the same list.
+        list_a.splice( list_a.cend(), list_a, list_a.cbegin() );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 20, 2, 3, 1 } ) );
+        EXPECT_EQ( list_a.size(), 4 );
+    }
+    {
+        BEGIN_TEST(tm3, "Splice 7", "splicing a range of elements.");
+        which_lib::list<int> list_a{ 1, 2, 3 };
+        which_lib::list<int> list_b{ 10, 20, 30, 40 };
+
+        list_a.splice( std::next( list_a.cbegin() ), list_b,
+                std::next( list_b.cbegin() ), std::prev( list_b.cend() ) );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 20, 30, 2, 3 } ) );
+        EXPECT_EQ( list_b, ( which_lib::list<int>{ 10, 40 } ) );
+        EXPECT_EQ( list_a.size(), 5 );
+        EXPECT_EQ( list_b.size(), 2 );
+
+        // Rotating inside the same list: move the first two elements to the end.
+        list_a.splice( list_a.cend(), list_a, list_a.cbegin(), std::next( list_a.cbegin(), 2 ) );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 30, 2, 3, 1, 20 } ) );
+        EXPECT_EQ( list_a.size(), 5 );
+
+        // An empty range changes nothing.
+        list_a.splice( list_a.cbegin(), list_b, list_b.cbegin(), list_b.cbegin() );
+        EXPECT_EQ( list_b.size(), 2 );
+    }
+
     {
         BEGIN_TEST(tm3, "Reverse 1", "reverse a regular list.");
         which_lib::list<int> list_a{ 1, 2, 3, 4, 5 };              // List B
@@ -997,6 +1323,31 @@ past_last = list.erase( std::next(list.begin(),2) );
     }
 
 
+    {
+        BEGIN_TEST(tm3, "Reverse 4", "reversing never copies the elements.");
+        int copies{0};
+        struct Counted {
+            int value;
+            int *copies;
+            Counted( int v = 0, int *c = nullptr ) : value{ v }, copies{ c } { }
+            Counted( const Counted &other ) : value{ other.value }, copies{ other.copies } { if ( copies ) ++*copies; }
+            Counted &operator=( const Counted &other ) { value = other.value; copies = other.copies; if ( copies ) ++*copies; return *this; }
+        };
+        which_lib::list<Counted> list_a;
+        for ( auto i{1} ; i <= 6 ; ++i )
+            list_a.push_back( Counted{ i, &copies } );
+        copies = 0;
+
+        list_a.reverse();
+        EXPECT_EQ( copies, 0 );
+        auto expected{6};
+        for ( auto it = list_a.cbegin() ; it != list_a.cend() ; ++it )
+            EXPECT_EQ( ( *it ).value, expected-- );
+        expected = 1;
+        for ( auto it = list_a.end() ; it != list_a.begin() ; )
+            EXPECT_EQ( ( *--it ).value, expected++ );
+    }
+
     {
         BEGIN_TEST(tm3, "Unique 1", "unique on a regular list.");
         which_lib::list<int> list_a{ 1, 2, 2, 3, 3, 2, 1, 1, 2 };              // List B
@@ -1054,8 +1405,8 @@ past_last = list.erase( std::next(list.begin(),2) );
         which_lib::list<int> list_r{ 1, 2, 3, 4, 5 }; // List Result
 
         list_a.sort();
-        auto add_first{ list_r.begin() };
-        auto add_last{ std::prev( list_r.end() ) };
+        auto add_first{ list_a.begin() };
+        auto add_last{ std::prev( list_a.end() ) };
         EXPECT_EQ( list_r, list_a ); // List A must be equal to list Result.
         // Make sure no new node has been created.
         *add_first = 10; // Iterators must remain valid.
@@ -1133,9 +1484,1258 @@ past_last = list.erase( std::next(list.begin(),2) );
         };
         EXPECT_EQ( list_r2, list_a ); // List A must be equal to list Result.
     }
+    {
+        BEGIN_TEST(tm3, "Sort 5", "sorting a large list only relinks nodes.");
+        which_lib::list<int> list_a;
+        unsigned seed{42};
+        for ( auto i{0} ; i < 100000 ; ++i )
+        {
+            seed = seed * 1103515245u + 12345u;
+            list_a.push_back( ( seed >> 8 ) % 1000 );
+        }
+        std::list<int> reference( list_a.begin(), list_a.end() );
+        auto first_node{ &*list_a.begin() };
+
+        list_a.sort();
+        reference.sort();
+        EXPECT_EQ( list_a.size(), reference.size() );
+        EXPECT_TRUE( std::equal( reference.begin(), reference.end(), list_a.begin() ) );
+        // The node that used to be first is still somewhere in the list.
+        EXPECT_NE( std::find_if( list_a.begin(), list_a.end(),
+                    [first_node]( const int &e ){ return &e == first_node; } ), list_a.end() );
+        // Links must be consistent when walking backwards too.
+        EXPECT_TRUE( std::equal( reference.rbegin(), reference.rend(),
+                    std::make_reverse_iterator( list_a.end() ) ) );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 6", "sorting with a custom comparison.");
+        which_lib::list<int> list_a{ 3, 1, 4, 1, 5, 9, 2, 6 };
+        which_lib::list<int> list_r{ 9, 6, 5, 4, 3, 2, 1, 1 };
+
+        list_a.sort( []( int a, int b ){ return a > b; } );
+        EXPECT_EQ( list_r, list_a );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 7", "parallel sort gives the same stable result as the sequential one.");
+        // Pairs (key, original position): sorting by key only must keep positions increasing.
+        which_lib::list<std::pair<int,int>> list_a;
+        unsigned seed{7};
+        for ( auto i{0} ; i < 50000 ; ++i )
+        {
+            seed = seed * 1103515245u + 12345u;
+            list_a.push_back( { static_cast<int>( ( seed >> 8 ) % 100 ), i } );
+        }
+        auto list_b{ list_a };
+        auto by_key = []( const std::pair<int,int> &a, const std::pair<int,int> &b ){ return a.first < b.first; };
+
+        list_a.sort( sc::execution::parallel_policy{ 1000, 5 }, by_key );
+        list_b.sort( by_key );
+        EXPECT_EQ( list_a.size(), 50000 );
+        EXPECT_EQ( list_a, list_b );
+
+        // Small lists go through the sequential path.
+        which_lib::list<int> list_c{ 3, 2, 1 };
+        list_c.sort( sc::execution::par );
+        EXPECT_EQ( list_c, ( which_lib::list<int>{ 1, 2, 3 } ) );
+    }
+    {
+        BEGIN_TEST(tm3, "Sort 8", "a throwing comparison does not lose nodes.");
+        which_lib::list<int> list_a;
+        for ( auto i{0} ; i < 5000 ; ++i )
+            list_a.push_back( ( i * 7919 ) % 5000 );
+
+        for ( auto threads : { 1u, 4u } )
+        {
+            std::atomic<int> calls{0};
+            bool thrown{false};
+            try {
+                list_a.sort( sc::execution::parallel_policy{ 100, threads },
+                        [&calls]( int a, int b ){ if ( ++calls == 20000 ) throw std::runtime_error("boom"); return a < b; } );
+            }
+            catch ( const std::runtime_error & ) { thrown = true; }
+            EXPECT_TRUE( thrown );
+            EXPECT_EQ( list_a.size(), 5000 );
+            EXPECT_EQ( static_cast<size_t>( std::distance( list_a.begin(), list_a.end() ) ), list_a.size() );
+        }
+        list_a.sort();
+        auto expected{0};
+        for ( auto e : list_a )
+            EXPECT_EQ( e, expected++ );
+    }
+
+    {
+        BEGIN_TEST(tm3, "SaveLoad", "binary save and load round-trip, and reject damaged data.");
+        struct Point { int x; double y; };
+        which_lib::list<Point> points;
+        for ( int i{0}; i < 300000; ++i ) points.push_back( { i, i * 0.5 } );
+        std::stringstream stream;
+        points.save( stream );
+        which_lib::list<Point> restored{ { -1, -1.0 } };
+        restored.load( stream );
+        bool same = restored.size() == points.size();
+        auto it = restored.begin();
+        for ( const auto &p : points )
+        {
+            same = same and it->x == p.x and it->y == p.y;
+            ++it;
+        }
+        EXPECT_TRUE( same );
+
+        which_lib::list<int> numbers{ 1, 2, 3, 4, 5 };
+        const std::string path{ "sc_list_save_load.bin" };
+        numbers.save( path );
+        which_lib::list<int> from_file;
+        from_file.load( path );
+        EXPECT_EQ( from_file, numbers );
+
+        which_lib::list<int> empty;
+        std::stringstream empty_stream;
+        empty.save( empty_stream );
+        from_file.load( empty_stream );
+        EXPECT_TRUE( from_file.empty() );
+
+        // A flipped byte, a short file and the wrong element type are all refused.
+        std::stringstream saved;
+        numbers.save( saved );
+        std::string bytes = saved.str();
+        auto fails = []( auto &list, const std::string &data ) {
+            std::stringstream in{ data };
+            try { list.load( in ); } catch ( const std::runtime_error & ) { return true; }
+            return false;
+        };
+        // A header claiming a huge count fails on the missing data, holding no memory for it.
+        std::string huge = bytes;
+        const std::uint64_t claimed = std::uint64_t{ 1 } << 60;
+        std::memcpy( &huge[ sizeof( which_lib::detail::list_file_magic ) ], &claimed, sizeof( claimed ) );
+        auto blocks = which_lib::pool_allocator<int>::system_blocks();
+        EXPECT_TRUE( fails( from_file, huge ) );
+        EXPECT_EQ( which_lib::pool_allocator<int>::system_blocks(), blocks );
+        std::string flipped = bytes;
+        flipped.back() ^= 0x01;
+        EXPECT_TRUE( fails( from_file, flipped ) );
+        EXPECT_TRUE( fails( from_file, bytes.substr( 0, bytes.size() - 1 ) ) );
+        EXPECT_TRUE( fails( from_file, "not a list" ) );
+        which_lib::list<long long> wide{ 7 };
+        EXPECT_TRUE( fails( wide, bytes ) );
+        EXPECT_EQ( wide.size(), 1u );
+        EXPECT_TRUE( from_file.empty() );
+        bool thrown = false;
+        try { from_file.load( std::string{ "no/such/dir/list.bin" } ); } catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        std::remove( path.c_str() );
+    }
+
+    {
+        BEGIN_TEST(tm3, "BulkBuild", "long ranges get their nodes back to back, and a throwing element changes nothing.");
+        std::vector<int> source( 5000 );
+        for ( size_t i{0} ; i < source.size() ; ++i ) source[i] = int( i );
+        // An element size no other test uses, so its pool starts out empty.
+        struct Wide {
+            int value;
+            char pad[92];
+            Wide( int v ) : value{ v }, pad{} { }
+        };
+        std::vector<Wide> wide( source.begin(), source.end() );
+
+        // Consecutive nodes sit at a fixed stride, in list order.
+        auto packed = []( const which_lib::list<Wide> &l ) {
+            auto it = l.cbegin();
+            const char *prev = reinterpret_cast<const char *>( &*it );
+            const std::ptrdiff_t stride = reinterpret_cast<const char *>( &*std::next( it ) ) - prev;
+            for ( ++it ; it != l.cend() ; ++it ) {
+                const char *here = reinterpret_cast<const char *>( &*it );
+                if ( here - prev != stride || stride <= 0 ) return false;
+                prev = here;
+            }
+            return true;
+        };
+        which_lib::list<Wide> built( wide.begin(), wide.end() );
+        EXPECT_EQ( built.size(), wide.size() );
+        EXPECT_TRUE( packed( built ) );
+        which_lib::list<Wide> copy( built );
+        EXPECT_EQ( copy.size(), built.size() );
+        EXPECT_EQ( copy.back().value, 4999 );
+        EXPECT_TRUE( packed( copy ) );
+        // The pool has enough free nodes now: they are reused instead of a new block.
+        auto blocks = which_lib::pool_allocator<int>::system_blocks();
+        copy.assign( wide.rbegin(), wide.rend() );
+        EXPECT_EQ( copy.front().value, 4999 );
+        EXPECT_EQ( which_lib::pool_allocator<int>::system_blocks(), blocks );
+        // A short run freed front to back is handed out again as a run.
+        which_lib::list<Wide> again( wide.begin(), wide.begin() + 300 );
+        EXPECT_TRUE( packed( again ) );
+        again.clear();
+        which_lib::list<Wide> sub( wide.begin(), wide.begin() + 200 );
+        EXPECT_TRUE( packed( sub ) );
+        EXPECT_EQ( which_lib::pool_allocator<int>::system_blocks(), blocks );
+
+        // Nodes of a run are still released one by one.
+        again.assign( wide.begin(), wide.end() );
+        again.erase( std::next( again.begin(), 10 ), std::next( again.begin(), 4000 ) );
+        again.insert( std::next( again.begin() ), wide.begin(), wide.begin() + 100 );
+        EXPECT_EQ( again.size(), 1110u );
+        EXPECT_EQ( again.at( 1 ).value, 0 );
+        EXPECT_EQ( again.at( 101 ).value, 1 );
+
+        // Copying and destroying over and over does not grow the pool.
+        which_lib::list<int> model( source.begin(), source.begin() + 1000 );
+        for ( int i{0} ; i < 10 ; ++i ) { which_lib::list<int> warm( model ); }
+        blocks = which_lib::pool_allocator<int>::system_blocks();
+        for ( int i{0} ; i < 20000 ; ++i ) { which_lib::list<int> churn( model ); }
+        EXPECT_EQ( which_lib::pool_allocator<int>::system_blocks(), blocks );
+
+        using local_list = which_lib::list<int, which_lib::pool_allocator<int>, which_lib::local_stats>;
+        local_list counted( source.begin(), source.end() );
+        EXPECT_EQ( counted.stats().allocations, 5000u );
+        EXPECT_EQ( counted.stats().peak_size, 5000u );
+
+        struct Fragile {
+            int value;
+            Fragile( int v ) : value{ v } { }
+            Fragile( const Fragile &other ) : value{ other.value } {
+                if ( value == 70 ) throw std::runtime_error( "fragile" );
+            }
+        };
+        std::vector<Fragile> fragile( source.begin(), source.begin() + 100 );
+        which_lib::list<Fragile> target;
+        target.push_back( Fragile{ -1 } );
+        bool thrown = false;
+        try { target.insert( target.begin(), fragile.begin(), fragile.end() ); } catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        EXPECT_EQ( target.size(), 1u );
+        EXPECT_EQ( target.begin()->value, -1 );
+    }
+
+    {
+        BEGIN_TEST(tm3, "RemoveIf", "remove, remove_if and erase_if unlink in one pass and report the count.");
+        which_lib::list<int> list_a{ 1, 2, 3, 2, 5, 2, 2 };
+        EXPECT_EQ( list_a.remove( 2 ), 4u );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 1, 3, 5 } ) );
+        EXPECT_EQ( list_a.remove( 4 ), 0u );
+        // The value may be one of the elements being removed.
+        list_a.push_back( 1 );
+        EXPECT_EQ( list_a.remove( list_a.front() ), 2u );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 3, 5 } ) );
+
+        using local_list = which_lib::list<int, which_lib::pool_allocator<int>, which_lib::local_stats>;
+        local_list big;
+        for ( int i{0} ; i < 10000 ; ++i ) big.push_back( i );
+        EXPECT_EQ( big.at( 5000 ), 5000 );
+        EXPECT_EQ( big.remove_if( []( int x ) { return x % 3 == 0; } ), 3334u );
+        EXPECT_EQ( big.size(), 6666u );
+        EXPECT_EQ( big.stats().deallocations, 3334u );
+        EXPECT_EQ( big.at( 5000 ), 7501 );
+        bool ok = true;
+        int count = 0;
+        for ( auto it = big.begin() ; it != big.end() ; ++it, ++count ) ok = ok && *it % 3 != 0;
+        for ( auto it = big.end() ; it != big.begin() ; --count ) ok = ok && *--it % 3 != 0;
+        EXPECT_TRUE( ok );
+        EXPECT_EQ( count, 0 );
+
+        EXPECT_EQ( which_lib::erase_if( big, []( int x ) { return x < 100; } ), 66u );
+        EXPECT_EQ( big.front(), 100 );
+        EXPECT_EQ( which_lib::erase_if( big, []( int ) { return true; } ), 6600u );
+        EXPECT_TRUE( big.empty() );
+
+        // A throwing predicate keeps what it removed so far and leaves a valid list.
+        which_lib::list<int> list_b{ 1, 2, 3, 4, 5 };
+        bool thrown = false;
+        try {
+            list_b.remove_if( []( int x ) { if ( x == 4 ) throw std::runtime_error( "stop" ); return x % 2 == 1; } );
+        } catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        EXPECT_EQ( list_b, ( which_lib::list<int>{ 2, 4, 5 } ) );
+        EXPECT_EQ( list_b.size(), 3u );
+    }
+
+    {
+        BEGIN_TEST(tm3, "Partition", "partition and stable_partition relink nodes and return the partition point.");
+        struct Task {
+            int priority;
+            std::unique_ptr<int> payload; // Move-only: the nodes cannot be copied around.
+        };
+        which_lib::list<Task> tasks;
+        for ( int i{0} ; i < 10 ; ++i ) tasks.push_back( Task{ i % 3, std::make_unique<int>( i ) } );
+        std::vector<const Task *> where;
+        for ( const Task &t : tasks ) where.push_back( &t );
+
+        auto urgent = []( const Task &t ) { return t.priority == 0; };
+        auto mid = tasks.stable_partition( tasks.cbegin(), tasks.cend(), urgent );
+        std::vector<int> order;
+        for ( const Task &t : tasks ) order.push_back( *t.payload );
+        EXPECT_TRUE( ( order == std::vector<int>{ 0, 3, 6, 9, 1, 2, 4, 5, 7, 8 } ) );
+        EXPECT_EQ( *mid->payload, 1 );
+        EXPECT_EQ( tasks.size(), 10u );
+        // Same nodes, same addresses.
+        bool same = true;
+        for ( const Task &t : tasks ) same = same && where[ size_t( *t.payload ) ] == &t;
+        EXPECT_TRUE( same );
+        int back_count = 0;
+        for ( auto it = tasks.end() ; it != tasks.begin() ; --it ) ++back_count;
+        EXPECT_EQ( back_count, 10 );
+
+        // A sub-range leaves the rest alone; an empty second group returns `last`.
+        auto sub_first = std::next( tasks.cbegin(), 4 );
+        auto sub_last = std::next( tasks.cbegin(), 8 );
+        mid = tasks.partition( sub_first, sub_last, []( const Task &t ) { return t.priority == 2; } );
+        order.clear();
+        for ( const Task &t : tasks ) order.push_back( *t.payload );
+        EXPECT_TRUE( ( order == std::vector<int>{ 0, 3, 6, 9, 2, 5, 1, 4, 7, 8 } ) );
+        EXPECT_EQ( *mid->payload, 1 );
+        which_lib::list<Task>::const_iterator none = tasks.partition( tasks.cbegin(), sub_last, []( const Task & ) { return true; } );
+        EXPECT_TRUE( ( none == sub_last ) );
+        EXPECT_EQ( *tasks.partition( tasks.cbegin(), tasks.cend(), []( const Task & ) { return false; } )->payload, 0 );
+
+        which_lib::list<int> list_a{ 1, 2, 3, 4, 5, 6 };
+        bool thrown = false;
+        try {
+            list_a.stable_partition( list_a.cbegin(), list_a.cend(), []( int x ) { if ( x == 5 ) throw std::runtime_error( "stop" ); return x % 2 == 0; } );
+        } catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        EXPECT_EQ( list_a, ( which_lib::list<int>{ 2, 4, 5, 6, 1, 3 } ) );
+        EXPECT_EQ( list_a.at( 5 ), 3 );
+    }
 
     std::cout << std::endl;
     tm3.summary();
 
+    //=== TESTING THE UNROLLED LIST
+    TestManager tm4{ "Unrolled List Test Suite"};
+
+    {
+        BEGIN_TEST(tm4, "UnrolledPushPop", "push and pop at both ends across node boundaries.");
+        sc::unrolled_list<int, 4> list;
+        for ( auto i{0} ; i < 10 ; ++i )
+        {
+            list.push_back( i );
+            list.push_front( -i-1 );
+        }
+        EXPECT_EQ( list.size(), 20 );
+        EXPECT_EQ( list.front(), -10 );
+        EXPECT_EQ( list.back(), 9 );
+
+        auto expected{-10};
+        for ( auto e : list )
+        {
+            EXPECT_EQ( e, expected );
+            ++expected;
+        }
+
+        while ( list.size() > 2 )
+        {
+            list.pop_front();
+            list.pop_back();
+        }
+        EXPECT_EQ( list, ( sc::unrolled_list<int, 4>{ -1, 0 } ) );
+    }
+
+    {
+        BEGIN_TEST(tm4, "UnrolledInsertErase", "insert and erase in the middle split and merge nodes.");
+        sc::unrolled_list<int, 4> list{ 1, 2, 3, 4, 5, 6, 7, 8 };
+
+        auto it = list.insert( std::next( list.begin(), 2 ), 42 );
+        EXPECT_EQ( *it, 42 );
+        EXPECT_EQ( list, ( sc::unrolled_list<int, 4>{ 1, 2, 42, 3, 4, 5, 6, 7, 8 } ) );
+
+        it = list.insert( std::next( list.begin(), 4 ), { 10, 20, 30 } );
+        EXPECT_EQ( *it, 10 );
+        EXPECT_EQ( list, ( sc::unrolled_list<int, 4>{ 1, 2, 42, 3, 10, 20, 30, 4, 5, 6, 7, 8 } ) );
+
+        it = list.erase( std::next( list.begin(), 2 ) );
+        EXPECT_EQ( *it, 3 );
+        it = list.erase( std::next( list.begin(), 3 ), std::next( list.begin(), 9 ) );
+        EXPECT_EQ( *it, 7 );
+        EXPECT_EQ( list, ( sc::unrolled_list<int, 4>{ 1, 2, 3, 7, 8 } ) );
+        EXPECT_EQ( list.size(), 5 );
+
+        it = list.erase( list.begin(), list.end() );
+        EXPECT_EQ( it, list.end() );
+        EXPECT_TRUE( list.empty() );
+    }
+
+    {
+        BEGIN_TEST(tm4, "UnrolledRandomOps", "random edits give the same result as std::list.");
+        sc::unrolled_list<std::string, 4> list;
+        std::list<std::string> reference;
+        unsigned seed{12345};
+        auto next_rand = [&seed]() { seed = seed * 1103515245u + 12345u; return ( seed >> 16 ) & 0x7fff; };
+
+        for ( auto step{0} ; step < 2000 ; ++step )
+        {
+            auto pos = reference.empty() ? 0 : next_rand() % ( reference.size() + 1 );
+            if ( next_rand() % 3 != 0 or reference.empty() )
+            {
+                auto value = std::to_string( step );
+                list.insert( std::next( list.begin(), pos ), value );
+                reference.insert( std::next( reference.begin(), pos ), value );
+            }
+            else
+            {
+                pos = pos % reference.size();
+                list.erase( std::next( list.begin(), pos ) );
+                reference.erase( std::next( reference.begin(), pos ) );
+            }
+        }
+        EXPECT_EQ( list.size(), reference.size() );
+        EXPECT_TRUE( std::equal( reference.begin(), reference.end(), list.begin() ) );
+
+        auto copy{ list };
+        EXPECT_EQ( copy, list );
+        EXPECT_EQ( *copy.find( *std::next( reference.begin(), 7 ) ), *std::next( reference.begin(), 7 ) );
+        EXPECT_EQ( copy.find( "missing" ), copy.end() );
+    }
+
+    {
+        BEGIN_TEST(tm4, "UnrolledOperations", "moves, splice, merge, sort, reverse and unique match std::list.");
+        using small_list = sc::unrolled_list<int, 4>;
+        static_assert( std::is_nothrow_move_constructible<small_list>::value, "" );
+        static_assert( std::is_nothrow_move_assignable<small_list>::value, "" );
+
+        small_list source { 1, 2, 3, 4, 5, 6 };
+        small_list moved( std::move( source ) );
+        EXPECT_EQ( moved, ( small_list{ 1, 2, 3, 4, 5, 6 } ) );
+        EXPECT_TRUE( source.empty() );
+        source.push_back( 7 ); // A moved-from list is still usable.
+        moved = std::move( source );
+        EXPECT_EQ( moved, ( small_list{ 7 } ) );
+        EXPECT_TRUE( source.empty() );
+
+        // Splicing into the middle of a node splits it; the other list is left empty.
+        small_list into { 1, 2, 3, 4, 5, 6, 7 };
+        small_list other { 10, 11, 12, 13, 14 };
+        into.splice( std::next( into.cbegin(), 2 ), other );
+        EXPECT_EQ( into, ( small_list{ 1, 2, 10, 11, 12, 13, 14, 3, 4, 5, 6, 7 } ) );
+        EXPECT_TRUE( other.empty() );
+        EXPECT_EQ( into.size(), 12u );
+        other.push_back( 0 );
+        into.splice( into.cend(), other );
+        into.splice( into.cbegin(), other ); // Empty: nothing happens.
+        EXPECT_EQ( into.back(), 0 );
+        EXPECT_EQ( std::distance( into.begin(), into.end() ), 13 );
+
+        unsigned seed{ 99 };
+        auto next_rand = [&seed]() { seed = seed * 1103515245u + 12345u; return ( seed >> 16 ) & 0x7fff; };
+        bool same{ true };
+        for ( int round{0}; round < 50; ++round )
+        {
+            small_list a, b;
+            std::list<int> ra, rb;
+            for ( auto i = next_rand() % 40; i > 0; --i ) { int v = next_rand() % 10; a.push_back( v ); ra.push_back( v ); }
+            for ( auto i = next_rand() % 40; i > 0; --i ) { int v = next_rand() % 10; b.push_back( v ); rb.push_back( v ); }
+            a.sort(); ra.sort();
+            b.sort(); rb.sort();
+            a.merge( b ); ra.merge( rb );
+            same = same and b.empty() and std::equal( a.begin(), a.end(), ra.begin(), ra.end() );
+            a.unique(); ra.unique();
+            a.reverse(); ra.reverse();
+            same = same and a.size() == ra.size() and std::equal( a.begin(), a.end(), ra.begin(), ra.end() );
+            same = same and std::distance( a.begin(), a.end() ) == static_cast<long>( a.size() );
+        }
+        EXPECT_TRUE( same );
+
+        // The sort is stable.
+        sc::unrolled_list<std::pair<int, int>, 4> pairs;
+        for ( int i{0}; i < 30; ++i ) pairs.push_back( { i % 3, i } );
+        pairs.sort( []( const std::pair<int, int> &x, const std::pair<int, int> &y ) { return x.first < y.first; } );
+        bool stable{ true };
+        for ( auto it = pairs.begin(); std::next( it ) != pairs.end(); ++it )
+            stable = stable and ( it->first < std::next( it )->first
+                                  or ( it->first == std::next( it )->first and it->second < std::next( it )->second ) );
+        EXPECT_TRUE( stable );
+
+        // A longer sort spans many rounds of in-place merges.
+        small_list big;
+        std::list<int> rbig;
+        for ( int i{0}; i < 5000; ++i ) { int v = next_rand() % 1000; big.push_back( v ); rbig.push_back( v ); }
+        big.sort( []( int x, int y ) { return x > y; } );
+        rbig.sort( []( int x, int y ) { return x > y; } );
+        EXPECT_TRUE( std::equal( big.begin(), big.end(), rbig.begin(), rbig.end() ) );
+
+        // Emplacement, rvalue pushes and the mutable ends.
+        sc::unrolled_list<std::unique_ptr<int>, 4> owners;
+        owners.push_front( std::make_unique<int>( 2 ) );
+        owners.emplace_back( new int( 3 ) );
+        owners.emplace_front( new int( 1 ) );
+        owners.emplace( std::next( owners.cbegin() ), new int( 9 ) );
+        *owners.front() = 0;
+        owners.back().reset( new int( 4 ) );
+        std::vector<int> seen;
+        for ( const auto &p : owners ) seen.push_back( *p );
+        EXPECT_TRUE( ( seen == std::vector<int>{ 0, 9, 2, 4 } ) );
+
+        // Every kind of splice, between two lists and within one, against std::list.
+        small_list x, y;
+        std::list<int> rx, ry;
+        bool spliced_ok{ true };
+        for ( int round{0}; round < 400; ++round )
+        {
+            while ( ry.size() < 30 ) { int v = next_rand(); y.push_back( v ); ry.push_back( v ); }
+            std::size_t p = next_rand() % ( rx.size() + 1 );
+            std::size_t i = next_rand() % ry.size();
+            std::size_t j = i + next_rand() % ( ry.size() - i + 1 );
+            switch ( next_rand() % 4 )
+            {
+            case 0:
+                x.splice( std::next( x.cbegin(), p ), y, std::next( y.cbegin(), i ) );
+                rx.splice( std::next( rx.begin(), p ), ry, std::next( ry.begin(), i ) );
+                break;
+            case 1:
+                x.splice( std::next( x.cbegin(), p ), y, std::next( y.cbegin(), i ), std::next( y.cbegin(), j ) );
+                rx.splice( std::next( rx.begin(), p ), ry, std::next( ry.begin(), i ), std::next( ry.begin(), j ) );
+                break;
+            case 2:
+                if ( rx.size() > 2 )
+                {
+                    std::size_t f = next_rand() % rx.size();
+                    std::size_t l = f + 1 + next_rand() % ( rx.size() - f );
+                    std::size_t at = next_rand() % ( rx.size() + 1 );
+                    if ( at > f and at < l ) at = l;
+                    x.splice( std::next( x.cbegin(), at ), x, std::next( x.cbegin(), f ), std::next( x.cbegin(), l ) );
+                    rx.splice( std::next( rx.begin(), at ), rx, std::next( rx.begin(), f ), std::next( rx.begin(), l ) );
+                }
+                break;
+            default:
+                if ( rx.size() > 100 ) { x.clear(); rx.clear(); }
+                x.splice( std::next( x.cbegin(), p ), y );
+                rx.splice( std::next( rx.begin(), p ), ry );
+                break;
+            }
+            spliced_ok = spliced_ok and x.size() == rx.size() and y.size() == ry.size()
+                      and std::equal( x.begin(), x.end(), rx.begin(), rx.end() )
+                      and std::equal( y.begin(), y.end(), ry.begin(), ry.end() )
+                      and std::distance( x.begin(), x.end() ) == static_cast<long>( x.size() );
+        }
+        EXPECT_TRUE( spliced_ok );
+    }
+
+    {
+        BEGIN_TEST(tm4, "UnrolledScans", "vectorized scans agree with the standard algorithms.");
+        unsigned seed{ 7 };
+        auto next_rand = [&seed]() { seed = seed * 1103515245u + 12345u; return ( seed >> 8 ); };
+        auto check = [&]( auto sample ) {
+            using T = decltype( sample );
+            std::vector<T> reference;
+            which_lib::unrolled_list<T> list;
+            for ( int i{0}; i < 1000; ++i )
+            {
+                // Spread the values over the whole range, including negative ones.
+                T value = static_cast<T>( static_cast<T>( static_cast<long long>( next_rand() % 200 ) - 100 )
+                                          * static_cast<T>( std::numeric_limits<T>::max() / 100 ) );
+                list.insert( std::next( list.begin(), next_rand() % ( list.size() + 1 ) ), value );
+                reference.assign( list.begin(), list.end() );
+            }
+            bool ok = list.min() == *std::min_element( reference.begin(), reference.end() )
+                  and list.max() == *std::max_element( reference.begin(), reference.end() );
+            // The first of equal elements is the one returned.
+            ok = ok and &list.min() == &*std::min_element( list.begin(), list.end() )
+                    and &list.max() == &*std::max_element( list.begin(), list.end() );
+            T sum{ 0 };
+            using U = std::make_unsigned_t<T>; // The list's sums wrap around.
+            for ( T v : reference ) sum = static_cast<T>( static_cast<U>( static_cast<U>( sum ) + static_cast<U>( v ) ) );
+            ok = ok and list.accumulate() == sum;
+            for ( int k{0}; k < 20; ++k )
+            {
+                T needle = reference[ next_rand() % reference.size() ];
+                auto expected = std::find( reference.begin(), reference.end(), needle ) - reference.begin();
+                ok = ok and std::distance( list.begin(), list.find( needle ) ) == expected
+                        and list.count( needle ) == static_cast<std::size_t>( std::count( reference.begin(), reference.end(), needle ) )
+                        and list.contains( needle );
+            }
+            ok = ok and not list.contains( static_cast<T>( 1 ) ) and list.count( static_cast<T>( 1 ) ) == 0;
+
+            // Same elements, different node layout.
+            which_lib::unrolled_list<T> other( reference.begin(), reference.end() );
+            ok = ok and other == list;
+            *std::prev( other.end() ) = static_cast<T>( 1 );
+            ok = ok and other != list;
+            return ok;
+        };
+        EXPECT_TRUE( check( int{} ) );
+        EXPECT_TRUE( check( unsigned{} ) );
+        EXPECT_TRUE( check( std::int64_t{} ) );
+        EXPECT_TRUE( check( std::uint64_t{} ) );
+        EXPECT_TRUE( check( short{} ) );
+
+        which_lib::unrolled_list<std::string> words { "pear", "apple", "fig" };
+        EXPECT_EQ( words.min(), std::string{ "apple" } );
+        EXPECT_EQ( words.max(), std::string{ "pear" } );
+        EXPECT_EQ( words.accumulate(), std::string{ "pearapplefig" } );
+        EXPECT_EQ( words.count( "fig" ), 1u );
+        // NaN never compares as better, so the result is still an element of the list.
+        which_lib::unrolled_list<double> with_nan { std::nan( "" ), 2.0, -1.0, std::nan( "" ) };
+        EXPECT_TRUE( std::isnan( with_nan.min() ) );
+        EXPECT_TRUE( std::isnan( with_nan.max() ) );
+        with_nan.pop_front();
+        EXPECT_EQ( with_nan.min(), -1.0 );
+        EXPECT_EQ( with_nan.max(), 2.0 );
+        bool thrown{ false };
+        try { which_lib::unrolled_list<int>{}.min(); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    std::cout << std::endl;
+    tm4.summary();
+
+    //=== TESTING THE INTRUSIVE LIST
+    TestManager tm5{ "Intrusive List Test Suite"};
+
+    struct Job
+    {
+        int id;
+        which_lib::list_hook by_queue;
+        which_lib::list_hook by_owner;
+        bool operator<( const Job &rhs ) const { return id < rhs.id; }
+    };
+    using queue_list = which_lib::intrusive_list<Job, &Job::by_queue>;
+    using owner_list = which_lib::intrusive_list<Job, &Job::by_owner>;
+    auto ids = []( queue_list &l ) { std::vector<int> v; for ( auto &j : l ) v.push_back( j.id ); return v; };
+
+    {
+        BEGIN_TEST(tm5, "IntrusiveLinks", "objects are linked in place and sit on two lists at once.");
+        Job jobs[5] = { {0,{},{}}, {1,{},{}}, {2,{},{}}, {3,{},{}}, {4,{},{}} };
+        queue_list queue;
+        owner_list owned;
+        for ( auto &j : jobs ) queue.push_back( j );
+        owned.push_front( jobs[1] );
+        owned.push_front( jobs[3] );
+        EXPECT_EQ( queue.size(), 5u );
+        EXPECT_EQ( &queue.front(), &jobs[0] );
+        EXPECT_EQ( &owned.front(), &jobs[3] );
+
+        // O(1) unlink of a known object, without touching the other list.
+        queue.erase( jobs[3] );
+        EXPECT_TRUE( ( ids( queue ) == std::vector<int>{ 0, 1, 2, 4 } ) );
+        EXPECT_FALSE( jobs[3].by_queue.is_linked() );
+        EXPECT_TRUE( jobs[3].by_owner.is_linked() );
+        EXPECT_EQ( owned.size(), 2u );
+
+        auto it = queue.insert( queue.iterator_to( jobs[1] ), jobs[3] );
+        EXPECT_EQ( &*it, &jobs[3] );
+        queue.pop_front();
+        queue.pop_back();
+        EXPECT_TRUE( ( ids( queue ) == std::vector<int>{ 3, 1, 2 } ) );
+
+        // Copies start unlinked.
+        Job copy = jobs[1];
+        EXPECT_FALSE( copy.by_queue.is_linked() );
+
+        queue_list moved( std::move( queue ) );
+        EXPECT_TRUE( queue.empty() );
+        EXPECT_TRUE( ( ids( moved ) == std::vector<int>{ 3, 1, 2 } ) );
+        moved.clear();
+        EXPECT_FALSE( jobs[1].by_queue.is_linked() );
+    }
+
+    {
+        BEGIN_TEST(tm5, "IntrusiveSpliceMerge", "splice and merge relink objects without copying.");
+        Job jobs[6] = { {0,{},{}}, {1,{},{}}, {2,{},{}}, {3,{},{}}, {4,{},{}}, {5,{},{}} };
+        queue_list a, b;
+        for ( int i : { 0, 2, 4 } ) a.push_back( jobs[i] );
+        for ( int i : { 1, 3, 5 } ) b.push_back( jobs[i] );
+        a.merge( b );
+        EXPECT_TRUE( b.empty() );
+        EXPECT_TRUE( ( ids( a ) == std::vector<int>{ 0, 1, 2, 3, 4, 5 } ) );
+        EXPECT_EQ( &a.back(), &jobs[5] );
+
+        b.splice( b.end(), a, a.iterator_to( jobs[2] ), a.iterator_to( jobs[5] ) );
+        EXPECT_TRUE( ( ids( a ) == std::vector<int>{ 0, 1, 5 } ) );
+        EXPECT_TRUE( ( ids( b ) == std::vector<int>{ 2, 3, 4 } ) );
+        a.splice( a.begin(), a, a.iterator_to( jobs[5] ) );
+        b.splice( b.begin(), a );
+        EXPECT_TRUE( a.empty() );
+        EXPECT_TRUE( ( ids( b ) == std::vector<int>{ 5, 0, 1, 2, 3, 4 } ) );
+        EXPECT_EQ( b.size(), 6u );
+    }
+
+    std::cout << std::endl;
+    tm5.summary();
+
+    //=== TESTING THE MPSC QUEUE
+    TestManager tm6{ "MPSC List Test Suite"};
+
+    {
+        BEGIN_TEST(tm6, "MpscSingleThread", "pop_front and drain keep FIFO order.");
+        which_lib::mpsc_list<std::string> queue;
+        EXPECT_TRUE( queue.empty() );
+        EXPECT_FALSE( queue.pop_front().has_value() );
+        queue.push_back( "a" );
+        queue.emplace_back( 3, 'b' );
+        std::string c{ "c" };
+        queue.push_back( c );
+        EXPECT_EQ( *queue.pop_front(), std::string{ "a" } );
+
+        which_lib::list<std::string> out { "x" };
+        EXPECT_EQ( queue.drain( out ), 2u );
+        EXPECT_EQ( out, ( which_lib::list<std::string>{ "x", "bbb", "c" } ) );
+        EXPECT_TRUE( queue.empty() );
+        queue.push_back( "left over" ); // Freed by the destructor.
+    }
+
+    {
+        BEGIN_TEST(tm6, "MpscProducers", "many producers, one consumer, nothing lost or reordered per producer.");
+        constexpr int producers = 4;
+        constexpr int per_producer = 20000;
+        which_lib::mpsc_list<std::pair<int,int>> queue;
+
+        std::vector<std::thread> threads;
+        for ( int p{0}; p < producers; ++p )
+            threads.emplace_back( [&queue, p]() {
+                for ( int i{0}; i < per_producer; ++i ) queue.push_back( { p, i } );
+            } );
+
+        std::vector<int> next( producers, 0 );
+        bool in_order{ true };
+        int received{ 0 };
+        which_lib::list<std::pair<int,int>> batch;
+        while ( received < producers * per_producer )
+        {
+            if ( received % 2 == 0 )
+            {
+                if ( auto item = queue.pop_front() )
+                {
+                    in_order = in_order and item->second == next[item->first]++;
+                    ++received;
+                }
+            }
+            else
+            {
+                queue.drain( batch );
+                for ( auto &item : batch )
+                {
+                    in_order = in_order and item.second == next[item.first]++;
+                    ++received;
+                }
+                batch.clear();
+            }
+        }
+        for ( auto &t : threads ) t.join();
+        EXPECT_TRUE( in_order );
+        EXPECT_EQ( received, producers * per_producer );
+        EXPECT_TRUE( queue.empty() );
+    }
+
+    std::cout << std::endl;
+    tm6.summary();
+
+    //=== TESTING THE INDEXED LIST
+    TestManager tm7{ "Indexed List Test Suite"};
+
+    {
+        BEGIN_TEST(tm7, "IndexedLookup", "find, count and erase by key follow every insertion and removal.");
+        which_lib::indexed_list<int> list{ 5, 3, 8 };
+        list.push_front( 1 );
+        list.push_back( 3 );
+        list.insert( list.find( 8 ), 7 );
+        std::vector<int> expected{ 1, 5, 3, 7, 8, 3 };
+        EXPECT_TRUE( ( std::vector<int>( list.begin(), list.end() ) == expected ) );
+        EXPECT_EQ( *list.find( 7 ), 7 );
+        EXPECT_TRUE( ( list.find( 4 ) == list.end() ) );
+        // Writing a key in place would leave the index pointing at the wrong slot.
+        static_assert( !writable_through< decltype( list.find( 2 ) ) >::value, "find() must not give write access" );
+        static_assert( !writable_through< decltype( list.begin() ) >::value, "begin() must not give write access" );
+        static_assert( !writable_through< which_lib::list<int>::const_iterator >::value, "const_iterator must be read-only" );
+        static_assert( writable_through< which_lib::list<int>::iterator >::value, "the check itself must see writes" );
+        EXPECT_EQ( list.count( 3 ), 2u );
+        EXPECT_EQ( list.erase( 3 ), 2u );
+        EXPECT_FALSE( list.contains( 3 ) );
+        list.pop_front();
+        list.pop_back();
+        EXPECT_FALSE( list.contains( 1 ) );
+        EXPECT_FALSE( list.contains( 8 ) );
+        EXPECT_EQ( list.size(), 2u );
+
+        // Enough elements to grow the table several times, then remove every other one.
+        which_lib::indexed_list<int> big;
+        for ( int i{0}; i < 5000; ++i ) big.push_back( i * 7 );
+        for ( int i{0}; i < 5000; i += 2 ) big.erase( big.find( i * 7 ) );
+        bool all_found = true;
+        for ( int i{0}; i < 5000; ++i )
+            all_found = all_found and ( big.contains( i * 7 ) == ( i % 2 == 1 ) );
+        EXPECT_TRUE( all_found );
+        EXPECT_EQ( big.size(), 2500u );
+        big.clear();
+        EXPECT_FALSE( big.contains( 7 ) );
+        bool thrown = false;
+        try { big.pop_front(); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    {
+        BEGIN_TEST(tm7, "IndexedSpliceMerge", "splice and merge move the index entries along with the nodes.");
+        struct Account { std::string name; int balance; bool operator<( const Account &rhs ) const { return name < rhs.name; } };
+        struct ByName { const std::string &operator()( const Account &a ) const { return a.name; } };
+        using accounts = which_lib::indexed_list<Account, ByName>;
+        accounts a{ { "ana", 10 }, { "caio", 30 } };
+        accounts b{ { "bia", 20 }, { "duda", 40 }, { "eva", 50 } };
+        EXPECT_EQ( a.find( "caio" )->balance, 30 );
+
+        a.splice( a.end(), b, b.find( "eva" ) );
+        EXPECT_TRUE( a.contains( "eva" ) );
+        EXPECT_FALSE( b.contains( "eva" ) );
+
+        a.merge( b );
+        EXPECT_TRUE( b.empty() );
+        EXPECT_FALSE( b.contains( "bia" ) );
+        EXPECT_EQ( a.size(), 5u );
+        EXPECT_EQ( a.find( "duda" )->balance, 40 );
+
+        accounts copy{ a };
+        copy.erase( copy.find( "ana" ) );
+        EXPECT_TRUE( a.contains( "ana" ) );
+        EXPECT_EQ( copy.size(), 4u );
+        b.splice( b.begin(), copy );
+        EXPECT_TRUE( copy.empty() );
+        EXPECT_EQ( b.find( "bia" )->balance, 20 );
+        EXPECT_FALSE( copy.contains( "bia" ) );
+    }
+
+    {
+        BEGIN_TEST(tm7, "LruCache", "hits move entries to the front and the least recently used one is evicted.");
+        which_lib::lru_cache<int, std::string> cache{ 3 };
+        cache.put( 1, "um" );
+        cache.put( 2, "dois" );
+        cache.put( 3, "tres" );
+        EXPECT_EQ( *cache.get( 1 ), "um" );    // 1 is now the most recent, 2 the least.
+        EXPECT_TRUE( ( cache.get( 9 ) == nullptr ) );
+        cache.put( 4, "quatro" );              // Evicts 2.
+        EXPECT_FALSE( cache.contains( 2 ) );
+        cache.put( 3, "TRES" );                // Updates 3 and makes it the most recent.
+        std::vector<int> order;
+        for ( const auto &e : cache ) order.push_back( e.key );
+        EXPECT_TRUE( ( order == std::vector<int>{ 3, 4, 1 } ) );
+        EXPECT_EQ( *cache.get( 3 ), "TRES" );
+        *cache.get( 4 ) = "four";
+        EXPECT_EQ( cache.begin()->value, "four" );
+        EXPECT_EQ( cache.hits(), 3u );
+        EXPECT_EQ( cache.misses(), 1u );
+        EXPECT_EQ( cache.evictions(), 1u );
+        EXPECT_TRUE( cache.erase( 1 ) );
+        EXPECT_FALSE( cache.erase( 1 ) );
+        EXPECT_EQ( cache.size(), 2u );
+
+        // Relinking on a hit must not touch the allocator.
+        which_lib::lru_cache<int, int, std::hash<int>, std::equal_to<>, tally_allocator<int>> ints{ 100 };
+        for ( int i{0}; i < 150; ++i ) ints.put( i, i * i );
+        int before = tally_allocator<int>::calls;
+        bool all_hit = true;
+        for ( int round{0}; round < 10; ++round )
+            for ( int i{50}; i < 150; ++i ) all_hit = all_hit and *ints.get( i ) == i * i;
+        EXPECT_TRUE( all_hit );
+        EXPECT_EQ( ints.evictions(), 50u );
+        EXPECT_EQ( tally_allocator<int>::calls, before );
+        bool thrown = false;
+        try { which_lib::lru_cache<int, int>{ 0 }; } catch ( const std::invalid_argument & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    std::cout << std::endl;
+    tm7.summary();
+
+    //=== TESTING THE MAPPED LIST
+    TestManager tm8{ "Mapped List Test Suite"};
+    const std::string mapped_path{ "sc_mapped_list.bin" };
+    std::remove( mapped_path.c_str() );
+
+    {
+        BEGIN_TEST(tm8, "MappedPersistence", "the list survives closing and reopening its file.");
+        {
+            which_lib::mapped_list<int> list{ mapped_path };
+            EXPECT_TRUE( list.empty() );
+            for ( int i{1}; i <= 5; ++i ) list.push_back( i );
+            list.push_front( 0 );
+            list.erase( list.find( 3 ) );
+            list.flush();
+        }
+        which_lib::mapped_list<int> reopened{ mapped_path };
+        std::vector<int> expected{ 0, 1, 2, 4, 5 };
+        EXPECT_TRUE( ( std::vector<int>( reopened.begin(), reopened.end() ) == expected ) );
+        reopened.reverse();
+        EXPECT_EQ( reopened.front(), 5 );
+        EXPECT_EQ( reopened.back(), 0 );
+        reopened.pop_back();
+        reopened.pop_front();
+        EXPECT_EQ( reopened.size(), 3u );
+
+        // A moved-from list has no file: it reads as empty and refuses inserts.
+        which_lib::mapped_list<int> owner{ std::move( reopened ) };
+        EXPECT_EQ( owner.size(), 3u );
+        EXPECT_FALSE( reopened.is_open() );
+        EXPECT_TRUE( reopened.empty() );
+        EXPECT_EQ( reopened.size(), 0u );
+        EXPECT_TRUE( ( reopened.begin() == reopened.end() ) );
+        reopened.reverse();
+        reopened.clear();
+        reopened.flush();
+        bool refused = false;
+        try { reopened.push_back( 1 ); } catch ( const std::logic_error & ) { refused = true; }
+        EXPECT_TRUE( refused );
+        reopened = std::move( owner );
+        EXPECT_TRUE( reopened.is_open() );
+        EXPECT_FALSE( owner.is_open() );
+        reopened.push_back( 9 );
+        EXPECT_EQ( reopened.back(), 9 );
+
+        bool thrown = false;
+        try { which_lib::mapped_list<long long> wrong{ mapped_path }; } catch ( const std::runtime_error & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    {
+        BEGIN_TEST(tm8, "MappedGrowth", "the file grows in chunks, iterators survive it and freed nodes are reused.");
+        struct Sample { long long id; double value; };
+        std::remove( mapped_path.c_str() );
+        which_lib::mapped_list<Sample> list{ mapped_path };
+        auto initial = list.file_size();
+        list.push_back( { -1, 0.0 } );
+        auto first = list.begin();
+        for ( long long i{0}; i < 200000; ++i ) list.push_back( { i, i * 0.25 } );
+        EXPECT_TRUE( ( list.file_size() > initial ) );
+        EXPECT_EQ( first->id, -1 );
+        EXPECT_EQ( list.back().id, 199999 );
+        bool in_order = true;
+        long long expected = -1;
+        for ( const auto &s : list ) in_order = in_order and s.id == expected++;
+        EXPECT_TRUE( in_order );
+
+        auto grown = list.file_size();
+        list.clear();
+        EXPECT_TRUE( list.empty() );
+        for ( long long i{0}; i < 200001; ++i ) list.push_front( { i, 0.0 } );
+        EXPECT_EQ( list.file_size(), grown );
+        EXPECT_EQ( list.front().id, 200000 );
+    }
+
+    {
+        BEGIN_TEST(tm8, "MappedOperations", "sort, merge, unique and splice match std::list.");
+        const std::string other_path{ "sc_mapped_list_other.bin" };
+        std::remove( mapped_path.c_str() );
+        std::remove( other_path.c_str() );
+        {
+            which_lib::mapped_list<int> list{ mapped_path };
+            which_lib::mapped_list<int> other{ other_path };
+            std::list<int> ra, rb;
+            unsigned seed{ 5 };
+            auto next_rand = [&seed]() { seed = seed * 1103515245u + 12345u; return static_cast<int>( ( seed >> 16 ) % 50 ); };
+            for ( int i{0}; i < 300; ++i ) { int v = next_rand(); list.push_back( v ); ra.push_back( v ); }
+            for ( int i{0}; i < 200; ++i ) { int v = next_rand(); other.push_back( v ); rb.push_back( v ); }
+            list.sort(); ra.sort();
+            other.sort(); rb.sort();
+            EXPECT_TRUE( std::equal( list.begin(), list.end(), ra.begin(), ra.end() ) );
+            list.merge( other ); ra.merge( rb );
+            EXPECT_TRUE( other.empty() );
+            EXPECT_TRUE( std::equal( list.begin(), list.end(), ra.begin(), ra.end() ) );
+            list.unique(); ra.unique();
+            EXPECT_TRUE( std::equal( list.begin(), list.end(), ra.begin(), ra.end() ) );
+            EXPECT_EQ( list.size(), ra.size() );
+            // Walking backwards checks the prev links the sort rebuilt.
+            EXPECT_TRUE( std::equal( std::make_reverse_iterator( list.end() ), std::make_reverse_iterator( list.begin() ),
+                                     ra.rbegin(), ra.rend() ) );
+
+            // Within one list, a range is relinked; from another list, it is copied.
+            list.splice( list.cbegin(), list, std::next( list.cbegin(), 10 ), std::next( list.cbegin(), 20 ) );
+            ra.splice( ra.begin(), ra, std::next( ra.begin(), 10 ), std::next( ra.begin(), 20 ) );
+            for ( int v : { 7, 8, 9 } ) { other.push_back( v ); rb.push_back( v ); }
+            list.splice( std::next( list.cbegin(), 5 ), other );
+            ra.splice( std::next( ra.begin(), 5 ), rb );
+            EXPECT_TRUE( other.empty() );
+            EXPECT_TRUE( std::equal( list.begin(), list.end(), ra.begin(), ra.end() ) );
+            list.flush();
+        }
+        which_lib::mapped_list<int> reopened{ mapped_path };
+        EXPECT_TRUE( std::is_sorted( std::next( reopened.begin(), 13 ), reopened.end() ) );
+        std::remove( other_path.c_str() );
+    }
+
+    {
+        BEGIN_TEST(tm8, "MappedCorruptHeader", "offsets in the header that point outside the file are rejected.");
+        // Offsets of header fields: size, used, free_head, root.next, root.prev.
+        const long fields[] = { 32, 40, 48, 56, 64 };
+        const std::uint64_t bad_values[] = { 1ull << 40, 8, 12345678901ull, 1ull << 40, 3 };
+        bool all_rejected{ true };
+        for ( std::size_t k{0}; k < 5; ++k )
+        {
+            std::remove( mapped_path.c_str() );
+            {
+                which_lib::mapped_list<int> list{ mapped_path };
+                for ( int i{0}; i < 10; ++i ) list.push_back( i );
+                list.pop_front(); // Leaves a node on the free list.
+                list.flush();
+            }
+            std::FILE *file = std::fopen( mapped_path.c_str(), "r+b" );
+            std::fseek( file, fields[k], SEEK_SET );
+            std::fwrite( &bad_values[k], sizeof( std::uint64_t ), 1, file );
+            std::fclose( file );
+            bool thrown{ false };
+            try { which_lib::mapped_list<int> list{ mapped_path }; } catch ( const std::runtime_error & ) { thrown = true; }
+            all_rejected = all_rejected and thrown;
+        }
+        EXPECT_TRUE( all_rejected );
+    }
+    std::remove( mapped_path.c_str() );
+
+    std::cout << std::endl;
+    tm8.summary();
+
+    //=== TESTING THE COMPACT LIST
+    TestManager tm9{ "Compact List Test Suite"};
+
+    {
+        BEGIN_TEST(tm9, "CompactRandomOps", "random edits give the same result as std::list.");
+        which_lib::compact_list<int> compact;
+        std::list<int> reference;
+        unsigned seed{ 12345 };
+        auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return ( seed >> 16 ) & 0x7fff; };
+        bool same = true;
+        for ( int step{0}; step < 20000; ++step )
+        {
+            int value = static_cast<int>( next() );
+            switch ( next() % 6 )
+            {
+                case 0: compact.push_back( value ); reference.push_back( value ); break;
+                case 1: compact.push_front( value ); reference.push_front( value ); break;
+                case 2: if ( !reference.empty() ) { compact.pop_back(); reference.pop_back(); } break;
+                case 3: if ( !reference.empty() ) { compact.pop_front(); reference.pop_front(); } break;
+                default:
+                {
+                    // Insert or erase at a random position.
+                    std::size_t at = reference.empty() ? 0 : next() % reference.size();
+                    auto c = compact.begin();
+                    auto r = reference.begin();
+                    std::advance( c, at );
+                    std::advance( r, at );
+                    if ( value % 2 == 0 or r == reference.end() ) { compact.insert( c, value ); reference.insert( r, value ); }
+                    else { compact.erase( c ); reference.erase( r ); }
+                }
+            }
+        }
+        same = compact.size() == reference.size() and std::equal( compact.begin(), compact.end(), reference.begin() );
+        EXPECT_TRUE( same );
+        compact.reverse();
+        reference.reverse();
+        EXPECT_TRUE( std::equal( compact.begin(), compact.end(), reference.begin() ) );
+        which_lib::compact_list<int> copy{ compact };
+        EXPECT_TRUE( ( copy == compact ) );
+        compact.clear();
+        EXPECT_TRUE( compact.empty() );
+        EXPECT_TRUE( ( copy != compact ) );
+        bool thrown = false;
+        try { compact.pop_back(); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    {
+        BEGIN_TEST(tm9, "CompactGrowth", "iterators survive slab growth and freed slots are reused.");
+        which_lib::compact_list<std::string> words{ "alfa", "beta" };
+        auto beta = std::next( words.begin() );
+        for ( int i{0}; i < 1000; ++i ) words.push_back( words.front() ); // Aliases an element while growing.
+        EXPECT_EQ( *beta, "beta" );
+        EXPECT_EQ( words.back(), "alfa" );
+        EXPECT_EQ( words.size(), 1002u );
+        auto capacity = words.capacity();
+        words.erase( std::next( words.begin(), 2 ), words.end() );
+        for ( int i{0}; i < 1000; ++i ) words.emplace_back( 5, 'x' );
+        EXPECT_EQ( words.capacity(), capacity );
+        EXPECT_EQ( words.back(), "xxxxx" );
+        EXPECT_TRUE( ( words.find( "beta" ) == beta ) );
+        which_lib::compact_list<int> reserved;
+        reserved.reserve( 100 );
+        EXPECT_TRUE( ( reserved.capacity() >= 100u ) );
+    }
+
+    std::cout << std::endl;
+    tm9.summary();
+
+    //=== TESTING THE XOR LIST
+    TestManager tm10{ "XOR List Test Suite"};
+
+    {
+        BEGIN_TEST(tm10, "XorBothEnds", "push, pop, insert and erase at both ends and in the middle.");
+        which_lib::xor_list<int> list{ 2, 3 };
+        list.push_front( 1 );
+        list.push_back( 4 );
+        list.emplace_back( 5 );
+        EXPECT_TRUE( ( std::vector<int>( list.begin(), list.end() ) == std::vector<int>{ 1, 2, 3, 4, 5 } ) );
+        std::vector<int> backwards;
+        for ( auto it = list.end(); it != list.begin(); ) backwards.push_back( *--it );
+        EXPECT_TRUE( ( backwards == std::vector<int>{ 5, 4, 3, 2, 1 } ) );
+
+        auto it = list.insert( list.find( 3 ), 30 ); // Before 3.
+        EXPECT_EQ( *it, 30 );
+        it = list.erase( ++it );                     // Erases 3.
+        EXPECT_EQ( *it, 4 );
+        list.pop_front();
+        list.pop_back();
+        EXPECT_TRUE( ( std::vector<int>( list.begin(), list.end() ) == std::vector<int>{ 2, 30, 4 } ) );
+        EXPECT_EQ( list.front(), 2 );
+        EXPECT_EQ( list.back(), 4 );
+
+        which_lib::xor_list<int> copy{ list };
+        EXPECT_TRUE( ( copy == list ) );
+        list.clear();
+        EXPECT_TRUE( list.empty() );
+        bool thrown = false;
+        try { list.pop_front(); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    {
+        BEGIN_TEST(tm10, "XorSpliceReverse", "reverse swaps the ends and splice moves whole lists.");
+        which_lib::xor_list<std::string> list{ "a", "b", "c" };
+        list.reverse();
+        EXPECT_TRUE( ( std::vector<std::string>( list.begin(), list.end() ) == std::vector<std::string>{ "c", "b", "a" } ) );
+        list.push_back( "z" );
+        list.push_front( "y" );
+        which_lib::xor_list<std::string> middle{ "1", "2" };
+        list.splice( list.find( "b" ), middle );
+        EXPECT_TRUE( middle.empty() );
+        which_lib::xor_list<std::string> tail{ "9" };
+        list.splice( list.end(), tail );
+        which_lib::xor_list<std::string> head{ "0" };
+        list.splice( list.begin(), head );
+        std::vector<std::string> expected{ "0", "y", "c", "1", "2", "b", "a", "z", "9" };
+        EXPECT_TRUE( ( std::vector<std::string>( list.begin(), list.end() ) == expected ) );
+        EXPECT_EQ( list.size(), expected.size() );
+        list.reverse();
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), expected.rbegin() ) );
+    }
+
+    std::cout << std::endl;
+    tm10.summary();
+
+    //=== TESTING THE EXPRESS LIST
+    TestManager tm11{ "Express List Test Suite"};
+
+    {
+        BEGIN_TEST(tm11, "ExpressPositions", "nth, advance and positional edits agree with std::vector.");
+        which_lib::express_list<int> list;
+        std::vector<int> reference;
+        unsigned seed{ 2024 };
+        auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return ( seed >> 8 ) & 0xffffff; };
+        bool same = true;
+        for ( int step{0}; step < 20000; ++step )
+        {
+            std::size_t at = next() % ( reference.size() + 1 );
+            if ( next() % 3 != 0 or reference.empty() )
+            {
+                list.insert( list.nth( at ), step );
+                reference.insert( reference.begin() + at, step );
+            }
+            else
+            {
+                at %= reference.size();
+                list.erase( list.nth( at ) );
+                reference.erase( reference.begin() + at );
+            }
+            if ( step % 97 == 0 and not reference.empty() )
+            {
+                std::size_t k = next() % reference.size();
+                same = same and *list.nth( k ) == reference[k];
+            }
+        }
+        EXPECT_TRUE( same );
+        EXPECT_EQ( list.size(), reference.size() );
+        EXPECT_TRUE( std::equal( list.begin(), list.end(), reference.begin() ) );
+
+        // Jumps in both directions, from the middle and from the ends.
+        auto it = list.nth( 100 );
+        it += 1000;
+        EXPECT_EQ( *it, reference[1100] );
+        it -= 1050;
+        EXPECT_EQ( *it, reference[50] );
+        EXPECT_EQ( *( list.end() - 1 ), reference.back() );
+        EXPECT_TRUE( ( list.begin() + static_cast<std::ptrdiff_t>( reference.size() ) == list.end() ) );
+        EXPECT_EQ( *list.advance( list.end(), -3 ), reference[reference.size() - 3] );
+        EXPECT_TRUE( ( list.nth( list.size() ) == list.end() ) );
+        bool thrown = false;
+        try { list.advance( list.begin(), -1 ); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        thrown = false;
+        try { list.nth( list.size() + 1 ); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    {
+        BEGIN_TEST(tm11, "ExpressBasics", "the std::list style API: ends, copies, moves and clear.");
+        which_lib::express_list<std::string> list{ "b", "c" };
+        list.push_front( "a" );
+        list.emplace_back( 2, 'd' );
+        list.pop_front();
+        EXPECT_EQ( list.front(), "b" );
+        EXPECT_EQ( list.back(), "dd" );
+        which_lib::express_list<std::string> copy{ list };
+        EXPECT_TRUE( ( copy == list ) );
+        which_lib::express_list<std::string> moved{ std::move( copy ) };
+        EXPECT_TRUE( ( moved == list ) );
+        // The moved-from list is empty and fully usable.
+        EXPECT_TRUE( copy.empty() );
+        EXPECT_TRUE( ( copy.begin() == copy.end() ) );
+        copy.push_back( "x" );
+        EXPECT_EQ( copy.at( 0 ), "x" );
+        which_lib::express_list<std::string> target{ "y" };
+        target = std::move( copy );
+        EXPECT_EQ( target.size(), 1u );
+        EXPECT_TRUE( copy.empty() );
+        copy.push_front( "w" );
+        EXPECT_EQ( copy.front(), "w" );
+
+        // Moves only relink the ends of each lane, so growing a vector keeps the nodes.
+        static_assert( std::is_nothrow_move_constructible<which_lib::express_list<int>>::value, "" );
+        std::vector<which_lib::express_list<int>> lists( 1 );
+        for ( int i{0}; i < 1000; ++i ) lists[0].push_back( i );
+        const int *first_node = &lists[0].front();
+        for ( int k{0}; k < 20; ++k ) lists.emplace_back();
+        EXPECT_EQ( &lists[0].front(), first_node );
+        lists[0].swap( lists[5] );
+        EXPECT_TRUE( lists[0].empty() );
+        bool ranks_ok = lists[5].size() == 1000u;
+        for ( std::size_t i{0}; i < 1000; i += 37 )
+            ranks_ok = ranks_ok and lists[5].at( i ) == static_cast<int>( i ) and lists[5].rank( lists[5].nth( i ) ) == i;
+        EXPECT_TRUE( ranks_ok );
+        lists[0].push_back( -1 );
+        lists[5].erase_at( 500 );
+        EXPECT_EQ( lists[5].at( 500 ), 501 );
+        EXPECT_EQ( lists[0].at( 0 ), -1 );
+        copy = moved;
+        copy.erase( copy.find( "c" ) );
+        EXPECT_EQ( *copy.nth( 1 ), "dd" );
+        moved.clear();
+        EXPECT_TRUE( moved.empty() );
+        moved.push_back( "z" );
+        EXPECT_EQ( *moved.nth( 0 ), "z" );
+    }
+
+    {
+        BEGIN_TEST(tm11, "ExpressRanks", "at, rank, distance, insert_at and erase_at on a large list.");
+        which_lib::express_list<int> list;
+        for ( int i{0}; i < 100000; ++i ) list.push_back( 2 * i );
+        EXPECT_EQ( list.at( 12345 ), 24690 );
+        auto it = list.find( 5000 );
+        EXPECT_EQ( list.rank( it ), 2500u );
+        EXPECT_EQ( list.rank( list.end() ), list.size() );
+        EXPECT_EQ( list.distance( it, list.nth( 2600 ) ), 100 );
+        EXPECT_EQ( list.distance( list.nth( 2600 ), it ), -100 );
+        EXPECT_EQ( list.end() - list.begin(), 100000 );
+
+        list.insert_at( 2500, -1 );       // Goes right before 5000.
+        EXPECT_EQ( list.rank( it ), 2501u );
+        EXPECT_EQ( list.at( 2500 ), -1 );
+        EXPECT_EQ( *list.erase_at( 2500 ), 5000 );
+        list.insert_at( list.size(), 7 );
+        EXPECT_EQ( list.back(), 7 );
+        list.erase_at( 0 );
+        EXPECT_EQ( list.front(), 2 );
+        EXPECT_EQ( list.rank( it ), 2499u );
+
+        bool thrown = false;
+        try { list.at( list.size() ); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+        thrown = false;
+        try { list.erase_at( list.size() ); } catch ( const std::out_of_range & ) { thrown = true; }
+        EXPECT_TRUE( thrown );
+    }
+
+    std::cout << std::endl;
+    tm11.summary();
+
     return 0;
 }